@@ -9,18 +9,22 @@
  * any/all aspects as you wish.
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "ActorGraph.hpp"
+#include "ConcurrentDisjointSet.hpp"
+#include "Workers.hpp"
 
 // using namespace std;
 
 /**
  * Constructor of the Actor graph
  */
-ActorGraph::ActorGraph() {}
+ActorGraph::ActorGraph() : castsOnly(false) {}
 
 /** You can modify this method definition as you wish
  *
@@ -34,6 +38,86 @@ ActorGraph::ActorGraph() {}
  */
 bool ActorGraph::loadFromFile(const char* in_filename,
                               bool use_weighted_edges) {
+    if (!readCastRows(in_filename, nullptr)) {
+        return false;
+    }
+
+    // Sorts each actor's edges by year so queries can be limited to a range
+    // of years without reloading
+    for (auto iter = actorList.begin(); iter != actorList.end(); iter++) {
+        iter->second->indexByYear();
+    }
+    buildComponents();
+
+    return true;
+}
+
+/**
+ * Loads the actors, movies and casts of a file of the same format as
+ * loadFromFile, without any Edges between costars, which take memory that
+ * grows with the square of each cast. Components are still labeled. Only
+ * what reads the casts, such as findExternalForest, works on such a graph;
+ * every Node has no edges.
+ * Params:
+ * - in_filename: input filename
+ * Returns: true if file was loaded sucessfully, false otherwise
+ */
+bool ActorGraph::loadCastsFromFile(const char* in_filename) {
+    castsOnly = true;
+    if (!readCastRows(in_filename, nullptr)) {
+        return false;
+    }
+    buildComponents();
+    return true;
+}
+
+/**
+ * Adds more rows of the same format as loadFromFile to a loaded graph. The
+ * year index of each actor with new edges is rebuilt once the file is read.
+ * Params:
+ * - in_filename: the file of new rows, with a header line
+ * - newEdges: filled with one new edge per new pair of costars, pointing
+ *             from the actor of the row to the costar
+ * - relabel: whether to label the components again, a pass over every cast;
+ *            if false, the components are stale until a later call relabels
+ *            them
+ * Returns: true if the file was read successfully, false otherwise
+ */
+bool ActorGraph::addFromFile(const char* in_filename, vector<Edge*>& newEdges,
+                             bool relabel) {
+    size_t firstNew = newEdges.size();
+    bool read = readCastRows(in_filename, &newEdges);
+
+    // Every new pair of costars has an edge from one to the other in newEdges
+    vector<bool> indexed(actorsById.size(), false);
+    for (size_t edge = firstNew; edge < newEdges.size(); edge++) {
+        for (Node* actor : {newEdges[edge]->getSource(),
+                            newEdges[edge]->getDest()}) {
+            if (!indexed[actor->getId()]) {
+                indexed[actor->getId()] = true;
+                actor->indexByYear();
+            }
+        }
+    }
+    if (!read) {
+        return false;
+    }
+    if (relabel) {
+        buildComponents();
+    }
+    return true;
+}
+
+/**
+ * Reads a tab-delimited file of actor->movie relationships, adding each row
+ * with insertCastRow without indexing the new edges by year
+ * Params:
+ * - in_filename: input filename
+ * - newEdges: if not nullptr, filled with the new edges as in addCastRow
+ * Returns: true if file was read sucessfully, false otherwise
+ */
+bool ActorGraph::readCastRows(const char* in_filename,
+                              vector<Edge*>* newEdges) {
     // Initialize the file stream
     ifstream infile(in_filename);
 
@@ -68,59 +152,7 @@ bool ActorGraph::loadFromFile(const char* in_filename,
             continue;
         }
 
-        string actor(record[0]);
-        string movie_title(record[1]);
-
-        int year = stoi(record[2]);
-        string title = movie_title + " " + record[2];
-        Movie movie = {title, movie_title, year};
-
-        // Builds graph up
-
-        if (movieList.find(movie) == movieList.end()) {
-            // if movie not in list
-            vector<Node*> cast;
-
-            if (actorList.find(actor) == actorList.end()) {
-                // actor not in list
-
-                Node* currActor = new Node(actor);
-                cast.push_back(currActor);
-                actorList[actor] = currActor;
-            } else {
-                // actor is in list
-
-                cast.push_back(actorList.find(actor)->second);
-            }
-            movieList[movie] = cast;
-        } else {
-            // movie is in list
-            vector<Node*> cast = movieList.find(movie)->second;
-            Node* currActor;
-
-            if (actorList.find(actor) == actorList.end()) {
-                // actor not in list
-                currActor = new Node(actor);
-                actorList[actor] = currActor;
-
-            } else {
-                // actor is in list
-                currActor = actorList.find(actor)->second;
-            }
-
-            for (int actor = 0; actor < cast.size(); actor++) {
-                // Adds each actor in the movie as an edge to current actor
-                Edge* edgeFromCurr = new Edge(currActor, cast[actor], movie);
-                // Adds edge from current to other
-                currActor->addEdge(edgeFromCurr);
-                Edge* edgeToCurr = new Edge(cast[actor], currActor, movie);
-                // Adds edge from other to curent
-                cast[actor]->addEdge(edgeToCurr);
-            }
-
-            cast.push_back(currActor);
-            movieList[movie] = cast;
-        }
+        insertCastRow(record[0], record[1], record[2], newEdges, false);
     }
 
     if (!infile.eof()) {
@@ -128,10 +160,85 @@ bool ActorGraph::loadFromFile(const char* in_filename,
         return false;
     }
     infile.close();
-
     return true;
 }
 
+/**
+ * Adds an actor to the cast of a movie, creating either if new, and connects
+ * the actor to everyone already in the cast with an edge each way unless the
+ * graph was loaded with loadCastsFromFile. The new edges are inserted into
+ * the year index of both actors.
+ * Params:
+ * - actor: the name of the actor
+ * - movie_title: the name of the movie
+ * - year: the year of the movie, as written in the file
+ * - newEdges: if not nullptr, the edge from the actor to each costar is
+ *             appended to it
+ * Returns: void
+ */
+void ActorGraph::addCastRow(string actor, string movie_title, string year,
+                            vector<Edge*>* newEdges) {
+    insertCastRow(actor, movie_title, year, newEdges, true);
+}
+
+/**
+ * Adds a row as addCastRow does, optionally leaving the year index of the
+ * actors given new edges to be rebuilt once the rows are all added
+ * Params:
+ * - actor: the name of the actor
+ * - movie_title: the name of the movie
+ * - year: the year of the movie, as written in the file
+ * - newEdges: if not nullptr, the edge from the actor to each costar is
+ *             appended to it
+ * - indexYears: whether to insert each new edge into the year index
+ * Returns: void
+ */
+void ActorGraph::insertCastRow(string actor, string movie_title, string year,
+                               vector<Edge*>* newEdges, bool indexYears) {
+    string title = movie_title + " " + year;
+    Movie movie = {title, movie_title, stoi(year), (int)moviesById.size()};
+
+    Node* currActor;
+    if (actorList.find(actor) == actorList.end()) {
+        // actor not in list
+        currActor = new Node(actor, actorsById.size());
+        actorList[actor] = currActor;
+        actorsById.push_back(currActor);
+    } else {
+        // actor is in list
+        currActor = actorList.find(actor)->second;
+    }
+
+    auto found = movieList.find(movie);
+    if (found == movieList.end()) {
+        // if movie not in list
+        moviesById.push_back(movie);
+        movieList[movie] = {currActor};
+        return;
+    }
+
+    // movie is in list
+    movie.id = found->first.id;
+    vector<Node*>& cast = found->second;
+    if (castsOnly) {
+        cast.push_back(currActor);
+        return;
+    }
+    for (int actor = 0; actor < (int)cast.size(); actor++) {
+        // Adds each actor in the movie as an edge to current actor
+        Edge* edgeFromCurr = new Edge(currActor, cast[actor], movie);
+        // Adds edge from current to other
+        currActor->addEdge(edgeFromCurr, indexYears);
+        Edge* edgeToCurr = new Edge(cast[actor], currActor, movie);
+        // Adds edge from other to curent
+        cast[actor]->addEdge(edgeToCurr, indexYears);
+        if (newEdges) {
+            newEdges->push_back(edgeFromCurr);
+        }
+    }
+    cast.push_back(currActor);
+}
+
 /**
  * Returns the node of the actor given their name
  * Params:
@@ -145,6 +252,129 @@ Node* ActorGraph::getActorNode(string actorName) {
     return actorList.find(actorName)->second;
 }
 
+/**
+ * Returns the node of the actor given their id
+ * Params:
+ * - actorId: the id of the actor, from 0 to getNumActors() - 1
+ * Returns: a pointer to the actor's Node
+ */
+Node* ActorGraph::getActorById(int actorId) { return actorsById[actorId]; }
+
+/**
+ * Returns the number of actors in the graph
+ * Params: None
+ * Returns: the number of actors
+ */
+int ActorGraph::getNumActors() { return actorsById.size(); }
+
+/**
+ * Returns the alphabetical rank of every actor's name, so that names can be
+ * ordered by comparing integers
+ * Params: None
+ * Returns: a vector of ranks from 0 to getNumActors() - 1, indexed by id
+ */
+vector<int> ActorGraph::getNameRanks() {
+    vector<int> ranks(actorsById.size());
+    int rank = 0;
+    // The map of actors is already in order of name
+    for (auto iter = actorList.begin(); iter != actorList.end(); iter++) {
+        ranks[iter->second->getId()] = rank++;
+    }
+    return ranks;
+}
+
+/**
+ * Returns the id of a movie given its title
+ * Params:
+ * - title: the name of the movie followed by a space and its year
+ * Returns: the id of the movie, or -1 if movie does not exist
+ */
+int ActorGraph::getMovieId(string title) {
+    Movie movie = {title, "", 0, -1};
+    if (movieList.find(movie) == movieList.end()) {
+        return -1;
+    }
+    return movieList.find(movie)->first.id;
+}
+
+/**
+ * Returns the movie given its id
+ * Params:
+ * - movieId: the id of the movie, from 0 to getNumMovies() - 1
+ * Returns: the movie with that id
+ */
+Movie ActorGraph::getMovieById(int movieId) { return moviesById[movieId]; }
+
+/**
+ * Returns the number of movies in the graph
+ * Params: None
+ * Returns: the number of movies
+ */
+int ActorGraph::getNumMovies() { return moviesById.size(); }
+
+/**
+ * Labels the connected component of every actor by uniting the cast of
+ * each movie, with the movies split between threads
+ * Params: None
+ * Returns: void
+ */
+void ActorGraph::buildComponents() {
+    vector<vector<Node*>*> casts;
+    for (auto iter = movieList.begin(); iter != movieList.end(); iter++) {
+        casts.push_back(&iter->second);
+    }
+
+    ConcurrentDisjointSet components(actorsById.size());
+    int numThreads = max(1, (int)thread::hardware_concurrency());
+    // Each thread unites the casts of every numThreads-th movie
+    runWorkers(numThreads, [&casts, &components, numThreads](int part) {
+        for (int movie = part; movie < (int)casts.size();
+             movie += numThreads) {
+            vector<Node*>& cast = *casts[movie];
+            for (int actor = 1; actor < (int)cast.size(); actor++) {
+                components.unite(cast[0]->getId(), cast[actor]->getId());
+            }
+        }
+    });
+
+    // Numbers the components in order of their first actor
+    componentOf.assign(actorsById.size(), -1);
+    componentSizes.clear();
+    for (int actor = 0; actor < (int)actorsById.size(); actor++) {
+        int root = components.find(actor);
+        if (componentOf[root] == -1) {
+            componentOf[root] = componentSizes.size();
+            componentSizes.push_back(0);
+        }
+        componentOf[actor] = componentOf[root];
+        componentSizes[componentOf[actor]]++;
+    }
+}
+
+/**
+ * Returns the connected component of an actor. Two actors are only
+ * connected by a path if they are in the same component.
+ * Params:
+ * - actor: the actor's Node
+ * Returns: the id of the actor's component, from 0 to
+ * getNumComponents() - 1
+ */
+int ActorGraph::getComponent(Node* actor) { return componentOf[actor->getId()]; }
+
+/**
+ * Returns the number of connected components
+ * Params: None
+ * Returns: the number of components
+ */
+int ActorGraph::getNumComponents() { return componentSizes.size(); }
+
+/**
+ * Returns the number of actors in each connected component
+ * Params: None
+ * Returns: a vector of sizes indexed by component id
+ */
+vector<int> ActorGraph::getComponentSizes() { return componentSizes; }
+
 /**
  * Returns the list of actors of a particular movie given its name
  * Params:
@@ -34,6 +34,44 @@ class ActorGraph {
     map<Movie, vector<Node*> >
         movieList;  // Hash map mapping movie names to list of actors
     map<string, Node*> actorList;  // Hash map mapping actors to their nodes
+    vector<Node*> actorsById;      // Actor nodes indexed by their ids
+    vector<Movie> moviesById;      // Movies indexed by their ids
+    vector<int> componentOf;       // Connected component of each actor id
+    vector<int> componentSizes;    // Number of actors in each component
+    bool castsOnly;                // Whether rows add no Edges between costars
+
+    /**
+     * Labels the connected component of every actor by uniting the cast of
+     * each movie, with the movies split between threads
+     * Params: None
+     * Returns: void
+     */
+    void buildComponents();
+
+    /**
+     * Adds a row as addCastRow does, optionally leaving the year index of
+     * the actors given new edges to be rebuilt once the rows are all added
+     * Params:
+     * - actor: the name of the actor
+     * - movie_title: the name of the movie
+     * - year: the year of the movie, as written in the file
+     * - newEdges: if not nullptr, the edge from the actor to each costar is
+     *             appended to it
+     * - indexYears: whether to insert each new edge into the year index
+     * Returns: void
+     */
+    void insertCastRow(string actor, string movie_title, string year,
+                       vector<Edge*>* newEdges, bool indexYears);
+
+    /**
+     * Reads a tab-delimited file of actor->movie relationships, adding each
+     * row with insertCastRow without indexing the new edges by year
+     * Params:
+     * - in_filename: input filename
+     * - newEdges: if not nullptr, filled with the new edges as in addCastRow
+     * Returns: true if file was read sucessfully, false otherwise
+     */
+    bool readCastRows(const char* in_filename, vector<Edge*>* newEdges);
 
   public:
     /**
@@ -53,6 +91,50 @@ class ActorGraph {
      */
     bool loadFromFile(const char* in_filename, bool use_weighted_edges);
 
+    /**
+     * Loads the actors, movies and casts of a file of the same format as
+     * loadFromFile, without any Edges between costars, which take memory
+     * that grows with the square of each cast. Components are still labeled.
+     * Only what reads the casts, such as findExternalForest, works on such a
+     * graph; every Node has no edges.
+     * Params:
+     * - in_filename: input filename
+     * Returns: true if file was loaded sucessfully, false otherwise
+     */
+    bool loadCastsFromFile(const char* in_filename);
+
+    /**
+     * Adds more rows of the same format as loadFromFile to a loaded graph. The
+     * year index of each actor with new edges is rebuilt once the file is
+     * read.
+     * Params:
+     * - in_filename: the file of new rows, with a header line
+     * - newEdges: filled with one new edge per new pair of costars, pointing
+     *             from the actor of the row to the costar
+     * - relabel: whether to label the components again, a pass over every
+     *            cast; if false, the components are stale until a later
+     *            call relabels them
+     * Returns: true if the file was read successfully, false otherwise
+     */
+    bool addFromFile(const char* in_filename, vector<Edge*>& newEdges,
+                     bool relabel = true);
+
+    /**
+     * Adds an actor to the cast of a movie, creating either if new, and
+     * connects the actor to everyone already in the cast with an edge each way
+     * unless the graph was loaded with loadCastsFromFile. The new edges are
+     * inserted into the year index of both actors.
+     * Params:
+     * - actor: the name of the actor
+     * - movie_title: the name of the movie
+     * - year: the year of the movie, as written in the file
+     * - newEdges: if not nullptr, the edge from the actor to each costar is
+     *             appended to it
+     * Returns: void
+     */
+    void addCastRow(string actor, string movie_title, string year,
+                    vector<Edge*>* newEdges = nullptr);
+
     /**
      * Returns the node of the actor given their name
      * Params:
@@ -61,6 +143,29 @@ class ActorGraph {
      */
     Node* getActorNode(string actorName);
 
+    /**
+     * Returns the node of the actor given their id
+     * Params:
+     * - actorId: the id of the actor, from 0 to getNumActors() - 1
+     * Returns: a pointer to the actor's Node
+     */
+    Node* getActorById(int actorId);
+
+    /**
+     * Returns the number of actors in the graph
+     * Params: None
+     * Returns: the number of actors
+     */
+    int getNumActors();
+
+    /**
+     * Returns the alphabetical rank of every actor's name, so that names can
+     * be ordered by comparing integers
+     * Params: None
+     * Returns: a vector of ranks from 0 to getNumActors() - 1, indexed by id
+     */
+    vector<int> getNameRanks();
+
     /**
      * Returns the list of actors of a particular movie given its name
      * Params:
@@ -70,6 +175,53 @@ class ActorGraph {
      */
     vector<Node*> getMovieCast(Movie movieName);
 
+    /**
+     * Returns the id of a movie given its title
+     * Params:
+     * - title: the name of the movie followed by a space and its year
+     * Returns: the id of the movie, or -1 if movie does not exist
+     */
+    int getMovieId(string title);
+
+    /**
+     * Returns the movie given its id
+     * Params:
+     * - movieId: the id of the movie, from 0 to getNumMovies() - 1
+     * Returns: the movie with that id
+     */
+    Movie getMovieById(int movieId);
+
+    /**
+     * Returns the number of movies in the graph
+     * Params: None
+     * Returns: the number of movies
+     */
+    int getNumMovies();
+
+    /**
+     * Returns the connected component of an actor. Two actors are only
+     * connected by a path if they are in the same component.
+     * Params:
+     * - actor: the actor's Node
+     * Returns: the id of the actor's component, from 0 to
+     * getNumComponents() - 1
+     */
+    int getComponent(Node* actor);
+
+    /**
+     * Returns the number of connected components
+     * Params: None
+     * Returns: the number of components
+     */
+    int getNumComponents();
+
+    /**
+     * Returns the number of actors in each connected component
+     * Params: None
+     * Returns: a vector of sizes indexed by component id
+     */
+    vector<int> getComponentSizes();
+
     /**
      * Deletes all nodes in ActorGraph
      * Params: None
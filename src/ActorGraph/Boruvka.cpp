@@ -0,0 +1,176 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the parallel
+ * Boruvka minimum spanning forest.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+#include "Boruvka.hpp"
+#include "ConcurrentDisjointSet.hpp"
+#include "DisjointSet.hpp"
+#include "EdgeSort.hpp"
+#include "Workers.hpp"
+
+// Marks a component without an outgoing edge
+#define NO_EDGE UINT64_MAX
+// Largest weight range and number of edges that fit a key's 32 bit halves;
+// an index of 0xFFFFFFFF could make a key equal to NO_EDGE
+#define MAX_KEY_WEIGHT 0xFFFFFFFFL
+#define MAX_KEY_EDGES 0xFFFFFFFFL
+
+/**
+ * Finds a minimum spanning forest with Kruskal's algorithm over the edges
+ * sorted by weight, for graphs whose edges cannot be keyed for Boruvka
+ * Params:
+ * - edges: the undirected edges of the graph, each given once, replaced by
+ *          the edges sorted by weight
+ * - numActors: the number of actor ids
+ * - numThreads: the number of threads to sort with
+ * Returns: the edges of the minimum spanning forest
+ */
+static vector<Edge*> findSortedForest(vector<Edge*>& edges, int numActors,
+                                      int numThreads) {
+    sortEdgesByWeight(edges, numThreads);
+    DisjointSet uptrees(numActors);
+    vector<Edge*> forest;
+    for (long edge = 0; edge < (long)edges.size(); edge++) {
+        if (uptrees.unite(edges[edge]->getSource()->getId(),
+                          edges[edge]->getDest()->getId())) {
+            forest.push_back(edges[edge]);
+        }
+    }
+    return forest;
+}
+
+/**
+ * Lowers an atomic value to candidate if candidate is smaller
+ * Params:
+ * - value: the atomic value
+ * - candidate: the new value
+ * Returns: void
+ */
+static void atomicMin(atomic<uint64_t>& value, uint64_t candidate) {
+    uint64_t current = value.load();
+    while (candidate < current &&
+           !value.compare_exchange_weak(current, candidate)) {
+        // current was reloaded by the failed exchange
+    }
+}
+
+/**
+ * Finds a minimum spanning forest with Boruvka's algorithm. Each round, the
+ * threads split the remaining edges and record the lightest edge leaving
+ * every component, then split the components and add each one's lightest
+ * edge, merging them in a concurrent union-find. Edges inside a component
+ * are dropped after every round, so each round touches fewer edges and the
+ * number of components at least halves.
+ * Ties between equal weights are broken by position in edges, which keeps the
+ * chosen edges acyclic, so the total weight equals Kruskal's. Each edge is
+ * keyed by its weight above the lightest in the high 32 bits and its
+ * position in the low 32 bits; if either does not fit, Kruskal's algorithm
+ * over the sorted edges is run instead.
+ * Params:
+ * - edges: the undirected edges of the graph, each given once, sorted by
+ *          weight if Kruskal's algorithm is run instead
+ * - numActors: the number of actor ids
+ * - numThreads: the number of threads to use
+ * Returns: the edges of the minimum spanning forest
+ */
+vector<Edge*> findBoruvkaForest(vector<Edge*>& edges, int numActors,
+                                int numThreads) {
+    numThreads = max(1, numThreads);
+    int minWeight = INT_MAX;
+    int maxWeight = INT_MIN;
+    for (long edge = 0; edge < (long)edges.size(); edge++) {
+        minWeight = min(minWeight, edges[edge]->getWeight());
+        maxWeight = max(maxWeight, edges[edge]->getWeight());
+    }
+    if ((long)edges.size() > MAX_KEY_EDGES ||
+        (!edges.empty() && (long)maxWeight - minWeight > MAX_KEY_WEIGHT)) {
+        return findSortedForest(edges, numActors, numThreads);
+    }
+
+    ConcurrentDisjointSet components(numActors);
+    vector<atomic<uint64_t>> lightest(numActors);  // Per component root
+    vector<vector<Edge*>> chosen(numThreads);      // Edges added per thread
+    vector<long> remaining(edges.size());          // Indices of live edges
+    for (long edge = 0; edge < (long)edges.size(); edge++) {
+        remaining[edge] = edge;
+    }
+
+    while (!remaining.empty()) {
+        for (int actor = 0; actor < numActors; actor++) {
+            lightest[actor].store(NO_EDGE, memory_order_relaxed);
+        }
+        long chunk = (remaining.size() + numThreads - 1) / numThreads;
+
+        // Finds the lightest edge leaving each component, keyed by weight
+        // then index so that every edge has a distinct key
+        vector<vector<long>> kept(numThreads);
+        runWorkers(numThreads, [&](int part) {
+            long last = min((long)remaining.size(), (part + 1) * chunk);
+            for (long index = part * chunk; index < last; index++) {
+                Edge* edge = edges[remaining[index]];
+                int source = components.find(edge->getSource()->getId());
+                int dest = components.find(edge->getDest()->getId());
+                if (source == dest) {
+                    // Inside a component, never needed again
+                    continue;
+                }
+                kept[part].push_back(remaining[index]);
+                uint64_t key =
+                    ((uint64_t)((long)edge->getWeight() - minWeight) << 32) |
+                    (uint64_t)remaining[index];
+                atomicMin(lightest[source], key);
+                atomicMin(lightest[dest], key);
+            }
+        });
+
+        // Adds each component's lightest edge; an edge chosen by both of its
+        // components only unites them once
+        long added = 0;
+        vector<long> addedPerThread(numThreads, 0);
+        int actorChunk = (numActors + numThreads - 1) / numThreads;
+        runWorkers(numThreads, [&](int part) {
+            int last = min(numActors, (part + 1) * actorChunk);
+            for (int actor = part * actorChunk; actor < last; actor++) {
+                uint64_t key = lightest[actor].load();
+                if (key == NO_EDGE) {
+                    continue;
+                }
+                Edge* edge = edges[key & 0xFFFFFFFF];
+                if (components.unite(edge->getSource()->getId(),
+                                     edge->getDest()->getId())) {
+                    chosen[part].push_back(edge);
+                    addedPerThread[part]++;
+                }
+            }
+        });
+        for (int part = 0; part < numThreads; part++) {
+            added += addedPerThread[part];
+        }
+
+        remaining.clear();
+        for (int part = 0; part < numThreads; part++) {
+            remaining.insert(remaining.end(), kept[part].begin(),
+                             kept[part].end());
+        }
+        if (added == 0) {
+            // No component has an edge leaving it
+            break;
+        }
+    }
+
+    vector<Edge*> forest;
+    for (int part = 0; part < numThreads; part++) {
+        forest.insert(forest.end(), chosen[part].begin(), chosen[part].end());
+    }
+    return forest;
+}
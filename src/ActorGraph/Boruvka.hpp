@@ -0,0 +1,41 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the parallel Boruvka
+ * minimum spanning forest.
+ */
+
+#ifndef BORUVKA_HPP
+#define BORUVKA_HPP
+
+#include <vector>
+
+#include "Edge.hpp"
+
+using namespace std;
+
+/**
+ * Finds a minimum spanning forest with Boruvka's algorithm. Each round, the
+ * threads split the remaining edges and record the lightest edge leaving
+ * every component, then split the components and add each one's lightest
+ * edge, merging them in a concurrent union-find. Edges inside a component
+ * are dropped after every round, so each round touches fewer edges and the
+ * number of components at least halves.
+ * Ties between equal weights are broken by position in edges, which keeps the
+ * chosen edges acyclic, so the total weight equals Kruskal's. Each edge is
+ * keyed by its weight above the lightest in the high 32 bits and its
+ * position in the low 32 bits; if either does not fit, Kruskal's algorithm
+ * over the sorted edges is run instead.
+ * Params:
+ * - edges: the undirected edges of the graph, each given once, sorted by
+ *          weight if Kruskal's algorithm is run instead
+ * - numActors: the number of actor ids
+ * - numThreads: the number of threads to use
+ * Returns: the edges of the minimum spanning forest
+ */
+vector<Edge*> findBoruvkaForest(vector<Edge*>& edges, int numActors,
+                                int numThreads);
+
+#endif
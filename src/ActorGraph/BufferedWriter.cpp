@@ -0,0 +1,123 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the BufferedWriter.
+ */
+
+#include <cstring>
+
+#include "BufferedWriter.hpp"
+
+// Most characters in a decimal long
+#define MAX_DIGITS 20
+
+/**
+ * Constructs a writer for a stream
+ * Params:
+ * - out: the stream to write to
+ */
+BufferedWriter::BufferedWriter(ostream& out)
+    : out(out), buffer(WRITE_BUFFER_SIZE), used(0) {}
+
+/**
+ * Writes whatever is left in the buffer
+ */
+BufferedWriter::~BufferedWriter() { flush(); }
+
+/**
+ * Appends text
+ * Params:
+ * - text: the text
+ * Returns: this writer
+ */
+BufferedWriter& BufferedWriter::operator<<(const string& text) {
+    if (used + text.size() > buffer.size()) {
+        flush();
+        if (text.size() > buffer.size()) {
+            // Too long to ever fit
+            out.write(text.data(), text.size());
+            return *this;
+        }
+    }
+    memcpy(buffer.data() + used, text.data(), text.size());
+    used += text.size();
+    return *this;
+}
+
+/**
+ * Appends text
+ * Params:
+ * - text: the null terminated text
+ * Returns: this writer
+ */
+BufferedWriter& BufferedWriter::operator<<(const char* text) {
+    for (; *text; text++) {
+        *this << *text;
+    }
+    return *this;
+}
+
+/**
+ * Appends a character
+ * Params:
+ * - letter: the character
+ * Returns: this writer
+ */
+BufferedWriter& BufferedWriter::operator<<(char letter) {
+    if (used == buffer.size()) {
+        flush();
+    }
+    buffer[used++] = letter;
+    return *this;
+}
+
+/**
+ * Appends an integer in decimal
+ * Params:
+ * - number: the integer
+ * Returns: this writer
+ */
+BufferedWriter& BufferedWriter::operator<<(long number) {
+    if (used + MAX_DIGITS > buffer.size()) {
+        flush();
+    }
+    // Digits are made from the lowest up, so negatives are kept negative to
+    // handle the smallest long
+    bool negative = number < 0;
+    char digits[MAX_DIGITS];
+    int length = 0;
+    do {
+        int digit = number % 10;
+        digits[length++] = '0' + (negative ? -digit : digit);
+        number /= 10;
+    } while (number != 0);
+    if (negative) {
+        buffer[used++] = '-';
+    }
+    while (length > 0) {
+        buffer[used++] = digits[--length];
+    }
+    return *this;
+}
+
+/**
+ * Appends an integer in decimal
+ * Params:
+ * - number: the integer
+ * Returns: this writer
+ */
+BufferedWriter& BufferedWriter::operator<<(int number) {
+    return *this << (long)number;
+}
+
+/**
+ * Writes the buffer to the stream and empties it
+ * Params: None
+ * Returns: void
+ */
+void BufferedWriter::flush() {
+    out.write(buffer.data(), used);
+    used = 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the BufferedWriter, which
+ * collects output in a large buffer and formats integers without streams.
+ */
+
+#ifndef BUFFEREDWRITER_HPP
+#define BUFFEREDWRITER_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Bytes collected before they are written out
+#define WRITE_BUFFER_SIZE (1 << 20)
+
+/**
+ * This class appends text and integers to a buffer that is handed to an
+ * output stream in one write whenever it fills, instead of formatting and
+ * flushing line by line.
+ */
+class BufferedWriter {
+  private:
+    ostream& out;         // Stream the buffer is written to
+    vector<char> buffer;  // Text not yet written
+    size_t used;          // Number of bytes of the buffer in use
+
+  public:
+    /**
+     * Constructs a writer for a stream
+     * Params:
+     * - out: the stream to write to
+     */
+    BufferedWriter(ostream& out);
+
+    /**
+     * Writes whatever is left in the buffer
+     */
+    ~BufferedWriter();
+
+    /**
+     * Appends text
+     * Params:
+     * - text: the text
+     * Returns: this writer
+     */
+    BufferedWriter& operator<<(const string& text);
+
+    /**
+     * Appends text
+     * Params:
+     * - text: the null terminated text
+     * Returns: this writer
+     */
+    BufferedWriter& operator<<(const char* text);
+
+    /**
+     * Appends a character
+     * Params:
+     * - letter: the character
+     * Returns: this writer
+     */
+    BufferedWriter& operator<<(char letter);
+
+    /**
+     * Appends an integer in decimal
+     * Params:
+     * - number: the integer
+     * Returns: this writer
+     */
+    BufferedWriter& operator<<(long number);
+
+    /**
+     * Appends an integer in decimal
+     * Params:
+     * - number: the integer
+     * Returns: this writer
+     */
+    BufferedWriter& operator<<(int number);
+
+    /**
+     * Writes the buffer to the stream and empties it
+     * Params: None
+     * Returns: void
+     */
+    void flush();
+};
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Gustavson, "Two Fast Algorithms for Sparse Matrices:
+ * Multiplication and Permuted Transposition"
+ * Description: This file contains the implementation for the CollabMatrix.
+ */
+
+#include <algorithm>
+#include <atomic>
+
+#include "CollabMatrix.hpp"
+#include "Workers.hpp"
+
+/**
+ * Builds the matrix of a graph from the movies in a range of years
+ * Params:
+ * - graph: the graph of all actors
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ */
+CollabMatrix::CollabMatrix(ActorGraph& graph, int fromYear, int toYear) {
+    rowStarts.push_back(0);
+    vector<int> costars;
+    for (int row = 0; row < graph.getNumActors(); row++) {
+        pair<EdgeIter, EdgeIter> edges =
+            graph.getActorById(row)->getEdgesInYears(fromYear, toYear);
+        costars.clear();
+        for (EdgeIter edge = edges.first; edge != edges.second; edge++) {
+            if ((*edge)->getDest()->getId() != row) {
+                costars.push_back((*edge)->getDest()->getId());
+            }
+        }
+        // One entry per costar, counting the movies shared
+        sort(costars.begin(), costars.end());
+        for (int costar = 0; costar < (int)costars.size(); costar++) {
+            if (costar > 0 && costars[costar] == costars[costar - 1]) {
+                values.back()++;
+            } else {
+                columns.push_back(costars[costar]);
+                values.push_back(1);
+            }
+        }
+        rowStarts.push_back(columns.size());
+    }
+}
+
+/**
+ * Returns the number of rows, one per actor id
+ * Params: None
+ * Returns: the number of rows
+ */
+int CollabMatrix::getNumRows() { return rowStarts.size() - 1; }
+
+/**
+ * Returns the number of nonzero entries in a row
+ * Params:
+ * - row: the actor id
+ * Returns: the number of collaborators of the actor
+ */
+int CollabMatrix::getRowLength(int row) {
+    return rowStarts[row + 1] - rowStarts[row];
+}
+
+/**
+ * Returns the columns of a row's entries, in order
+ * Params:
+ * - row: the actor id
+ * Returns: a pointer to getRowLength(row) ids of collaborators
+ */
+const int* CollabMatrix::getColumns(int row) {
+    return columns.data() + rowStarts[row];
+}
+
+/**
+ * Returns the values of a row's entries, in order of column
+ * Params:
+ * - row: the actor id
+ * Returns: a pointer to getRowLength(row) numbers of shared movies
+ */
+const int* CollabMatrix::getValues(int row) {
+    return values.data() + rowStarts[row];
+}
+
+/**
+ * Returns the entries of a row, in order of column
+ * Params:
+ * - row: the actor id
+ * Returns: a vector of (column, value) pairs
+ */
+vector<Entry> CollabMatrix::getRow(int row) {
+    vector<Entry> entries;
+    for (long entry = rowStarts[row]; entry < rowStarts[row + 1]; entry++) {
+        entries.push_back({columns[entry], values[entry]});
+    }
+    return entries;
+}
+
+/**
+ * Computes rows of A * A with Gustavson's row by row product, split
+ * between threads. Each thread takes the next query row and accumulates
+ * its product one tile of TILE_COLUMNS columns at a time in a dense array
+ * that stays in cache, keeping a cursor into every row it merges so that
+ * each entry is still read once per query row. The product row is handed
+ * to consume on the thread that computed it, so that it can be reduced
+ * at once instead of being stored.
+ * Params:
+ * - rows: the rows of the product to compute
+ * - numThreads: the number of threads to use
+ * - consume: called with the index of each query in rows and its row of
+ *            the product, in order of column, with zeros left out
+ * Returns: void
+ */
+void CollabMatrix::multiplyRows(const vector<int>& rows, int numThreads,
+                                function<void(int, vector<Entry>&)> consume) {
+    atomic<int> nextQuery(0);
+    int numColumns = getNumRows();
+    auto worker = [&](int) {
+        vector<int> tile(min(TILE_COLUMNS, max(1, numColumns)), 0);
+        vector<int> touched;      // Columns of the tile that are nonzero
+        vector<long> cursors;     // Next entry of each merged row
+        vector<Entry> product;
+        for (int query = nextQuery++; query < (int)rows.size();
+             query = nextQuery++) {
+            int row = rows[query];
+            cursors.clear();
+            for (long entry = rowStarts[row]; entry < rowStarts[row + 1];
+                 entry++) {
+                cursors.push_back(rowStarts[columns[entry]]);
+            }
+            product.clear();
+
+            for (int first = 0; first < numColumns; first += TILE_COLUMNS) {
+                int last = min(numColumns, first + TILE_COLUMNS);
+                for (long entry = rowStarts[row]; entry < rowStarts[row + 1];
+                     entry++) {
+                    // Adds A[row][middle] * A[middle][column] for the columns
+                    // of middle's row that fall in this tile
+                    int middle = columns[entry];
+                    int weight = values[entry];
+                    long& cursor = cursors[entry - rowStarts[row]];
+                    long end = rowStarts[middle + 1];
+                    for (; cursor < end && columns[cursor] < last; cursor++) {
+                        int& sum = tile[columns[cursor] - first];
+                        if (sum == 0) {
+                            touched.push_back(columns[cursor]);
+                        }
+                        sum += weight * values[cursor];
+                    }
+                }
+                sort(touched.begin(), touched.end());
+                for (int column : touched) {
+                    product.push_back({column, tile[column - first]});
+                    tile[column - first] = 0;
+                }
+                touched.clear();
+            }
+            consume(query, product);
+        }
+    };
+
+    runWorkers(numThreads, worker);
+}
+
+/**
+ * Adds to entries of the matrix, such as those of the costars of new
+ * movies, and adds empty rows for new actors. Rows without additions are
+ * copied in blocks, so the cost is one pass over the entries instead of
+ * over the graph.
+ * Params:
+ * - numRows: the number of rows afterwards, at least getNumRows()
+ * - additions: the row, column and amount of each addition, in any order;
+ *   additions to the same entry are summed
+ * Returns: void
+ */
+void CollabMatrix::addEntries(int numRows, vector<RowEntry>& additions) {
+    rowStarts.resize(numRows + 1, rowStarts.back());
+    if (additions.empty()) {
+        return;
+    }
+    sort(additions.begin(), additions.end());
+    vector<int> newColumns;
+    vector<int> newValues;
+    newColumns.reserve(columns.size() + additions.size());
+    newValues.reserve(values.size() + additions.size());
+    vector<long> newStarts(numRows + 1, 0);
+
+    int copied = 0;  // Rows before this one are in the new arrays
+    for (int next = 0; next < (int)additions.size();) {
+        int row = additions[next].first;
+        // Rows up to this one are unchanged, so they are copied as a block
+        long first = rowStarts[copied];
+        long last = rowStarts[row];
+        newColumns.insert(newColumns.end(), columns.begin() + first,
+                          columns.begin() + last);
+        newValues.insert(newValues.end(), values.begin() + first,
+                         values.begin() + last);
+        for (int unchanged = copied; unchanged < row; unchanged++) {
+            newStarts[unchanged + 1] =
+                newStarts[unchanged] + rowStarts[unchanged + 1] -
+                rowStarts[unchanged];
+        }
+
+        // Merges the row with its additions, both in order of column
+        long entry = rowStarts[row];
+        long end = rowStarts[row + 1];
+        for (; next < (int)additions.size() && additions[next].first == row;
+             next++) {
+            Entry& addition = additions[next].second;
+            for (; entry < end && columns[entry] < addition.first; entry++) {
+                newColumns.push_back(columns[entry]);
+                newValues.push_back(values[entry]);
+            }
+            if ((long)newColumns.size() > newStarts[row] &&
+                newColumns.back() == addition.first) {
+                newValues.back() += addition.second;
+            } else if (entry < end && columns[entry] == addition.first) {
+                newColumns.push_back(columns[entry]);
+                newValues.push_back(values[entry++] + addition.second);
+            } else {
+                newColumns.push_back(addition.first);
+                newValues.push_back(addition.second);
+            }
+        }
+        newColumns.insert(newColumns.end(), columns.begin() + entry,
+                          columns.begin() + end);
+        newValues.insert(newValues.end(), values.begin() + entry,
+                         values.begin() + end);
+        newStarts[row + 1] = newColumns.size();
+        copied = row + 1;
+    }
+    long first = rowStarts[copied];
+    newColumns.insert(newColumns.end(), columns.begin() + first, columns.end());
+    newValues.insert(newValues.end(), values.begin() + first, values.end());
+    for (int unchanged = copied; unchanged < numRows; unchanged++) {
+        newStarts[unchanged + 1] = newStarts[unchanged] +
+                                   rowStarts[unchanged + 1] -
+                                   rowStarts[unchanged];
+    }
+    columns.swap(newColumns);
+    values.swap(newValues);
+    rowStarts.swap(newStarts);
+}
@@ -0,0 +1,123 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Gustavson, "Two Fast Algorithms for Sparse Matrices:
+ * Multiplication and Permuted Transposition"
+ * Description: This file contains the declaration of the CollabMatrix, the
+ * weighted collaboration matrix of a graph in compressed sparse rows.
+ */
+
+#ifndef COLLABMATRIX_HPP
+#define COLLABMATRIX_HPP
+
+#include <functional>
+#include <vector>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+// Columns of the product accumulated at once, sized to stay in cache
+#define TILE_COLUMNS (1 << 14)
+
+// A column of a sparse row and its value
+typedef pair<int, int> Entry;
+
+// A row and an entry of it
+typedef pair<int, Entry> RowEntry;
+
+/**
+ * This class represents the symmetric matrix A whose entry A[x][y] is the
+ * number of movies actors x and y made together in a range of years, stored
+ * as compressed sparse rows sorted by column. Self collaborations are left
+ * out, so the diagonal is zero.
+ */
+class CollabMatrix {
+  private:
+    vector<long> rowStarts;  // Index of each row's first entry, plus the end
+    vector<int> columns;     // Column of each entry
+    vector<int> values;      // Value of each entry
+
+  public:
+    /**
+     * Builds the matrix of a graph from the movies in a range of years
+     * Params:
+     * - graph: the graph of all actors
+     * - fromYear: the earliest year of a movie to count
+     * - toYear: the latest year of a movie to count
+     */
+    CollabMatrix(ActorGraph& graph, int fromYear, int toYear);
+
+    /**
+     * Returns the number of rows, one per actor id
+     * Params: None
+     * Returns: the number of rows
+     */
+    int getNumRows();
+
+    /**
+     * Returns the number of nonzero entries in a row
+     * Params:
+     * - row: the actor id
+     * Returns: the number of collaborators of the actor
+     */
+    int getRowLength(int row);
+
+    /**
+     * Returns the columns of a row's entries, in order
+     * Params:
+     * - row: the actor id
+     * Returns: a pointer to getRowLength(row) ids of collaborators
+     */
+    const int* getColumns(int row);
+
+    /**
+     * Returns the values of a row's entries, in order of column
+     * Params:
+     * - row: the actor id
+     * Returns: a pointer to getRowLength(row) numbers of shared movies
+     */
+    const int* getValues(int row);
+
+    /**
+     * Returns the entries of a row, in order of column
+     * Params:
+     * - row: the actor id
+     * Returns: a vector of (column, value) pairs
+     */
+    vector<Entry> getRow(int row);
+
+    /**
+     * Computes rows of A * A with Gustavson's row by row product, split
+     * between threads. Each thread takes the next query row and accumulates
+     * its product one tile of TILE_COLUMNS columns at a time in a dense array
+     * that stays in cache, keeping a cursor into every row it merges so that
+     * each entry is still read once per query row. The product row is handed
+     * to consume on the thread that computed it, so that it can be reduced
+     * at once instead of being stored.
+     * Params:
+     * - rows: the rows of the product to compute
+     * - numThreads: the number of threads to use
+     * - consume: called with the index of each query in rows and its row of
+     *            the product, in order of column, with zeros left out
+     * Returns: void
+     */
+    void multiplyRows(const vector<int>& rows, int numThreads,
+                      function<void(int, vector<Entry>&)> consume);
+
+    /**
+     * Adds to entries of the matrix, such as those of the costars of new
+     * movies, and adds empty rows for new actors. Rows without additions are
+     * copied in blocks, so the cost is one pass over the entries instead of
+     * over the graph.
+     * Params:
+     * - numRows: the number of rows afterwards, at least getNumRows()
+     * - additions: the row, column and amount of each addition, in any order;
+     *   additions to the same entry are summed
+     * Returns: void
+     */
+    void addEntries(int numRows, vector<RowEntry>& additions);
+};
+
+#endif
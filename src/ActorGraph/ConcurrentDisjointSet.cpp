@@ -0,0 +1,78 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Anderson and Woll, "Wait-free Parallel Algorithms for the
+ * Union-Find Problem"
+ * Description: This file contains the implementation for the
+ * ConcurrentDisjointSet, a lock-free union-find.
+ */
+
+#include "ConcurrentDisjointSet.hpp"
+
+/**
+ * Constructs sets that each hold a single id
+ * Params:
+ * - size: the number of ids
+ */
+ConcurrentDisjointSet::ConcurrentDisjointSet(int size) : parents(size) {
+    for (int element = 0; element < size; element++) {
+        parents[element].store(element, memory_order_relaxed);
+    }
+}
+
+/**
+ * Returns the root of the set containing an id. Safe to call while other
+ * threads are uniting sets.
+ * Params:
+ * - element: the id to find
+ * Returns: the id at the root of element's set
+ */
+int ConcurrentDisjointSet::find(int element) {
+    while (true) {
+        int parent = parents[element].load();
+        if (parent == element) {
+            return element;
+        }
+        int grandparent = parents[parent].load();
+        if (parent != grandparent) {
+            // Path halving; losing the race to another thread is harmless
+            parents[element].compare_exchange_weak(parent, grandparent);
+        }
+        element = grandparent;
+    }
+}
+
+/**
+ * Merges the sets containing two ids. Safe to call from many threads.
+ * Params:
+ * - first: an id in the first set
+ * - second: an id in the second set
+ * Returns: true if the sets were merged, false if already the same set
+ */
+bool ConcurrentDisjointSet::unite(int first, int second) {
+    while (true) {
+        first = find(first);
+        second = find(second);
+        if (first == second) {
+            return false;
+        }
+        if (first > second) {
+            // Always links the larger root under the smaller one
+            int temp = first;
+            first = second;
+            second = temp;
+        }
+        int expected = second;
+        if (parents[second].compare_exchange_strong(expected, first)) {
+            return true;
+        }
+        // second stopped being a root, so tries again from the new roots
+    }
+}
+
+/**
+ * Returns the number of ids
+ * Returns: the number of ids in all sets
+ */
+int ConcurrentDisjointSet::size() { return parents.size(); }
@@ -0,0 +1,62 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Anderson and Woll, "Wait-free Parallel Algorithms for the
+ * Union-Find Problem"
+ * Description: This file contains the declaration of the ConcurrentDisjointSet,
+ * a union-find over dense ids that many threads can update at once.
+ */
+
+#ifndef CONCURRENTDISJOINTSET_HPP
+#define CONCURRENTDISJOINTSET_HPP
+
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+/**
+ * This class represents disjoint sets of the ids 0 to size - 1 as uptrees
+ * whose parents are atomic. Roots are always linked under the smaller root id
+ * with a compare and swap, so concurrent unions never form a cycle, and finds
+ * halve their path as they go.
+ */
+class ConcurrentDisjointSet {
+  private:
+    vector<atomic<int>> parents;  // Parent of each id, itself if a root
+
+  public:
+    /**
+     * Constructs sets that each hold a single id
+     * Params:
+     * - size: the number of ids
+     */
+    ConcurrentDisjointSet(int size);
+
+    /**
+     * Returns the root of the set containing an id. Safe to call while other
+     * threads are uniting sets.
+     * Params:
+     * - element: the id to find
+     * Returns: the id at the root of element's set
+     */
+    int find(int element);
+
+    /**
+     * Merges the sets containing two ids. Safe to call from many threads.
+     * Params:
+     * - first: an id in the first set
+     * - second: an id in the second set
+     * Returns: true if the sets were merged, false if already the same set
+     */
+    bool unite(int first, int second);
+
+    /**
+     * Returns the number of ids
+     * Returns: the number of ids in all sets
+     */
+    int size();
+};
+
+#endif
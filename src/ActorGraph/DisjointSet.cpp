@@ -0,0 +1,74 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the DisjointSet, a
+ * union-find with path compression and union by rank.
+ */
+
+#include "DisjointSet.hpp"
+
+/**
+ * Constructs sets that each hold a single id
+ * Params:
+ * - size: the number of ids
+ */
+DisjointSet::DisjointSet(int size) : parents(size), ranks(size, 0) {
+    for (int element = 0; element < size; element++) {
+        parents[element] = element;
+    }
+    numSets = size;
+}
+
+/**
+ * Returns the root of the set containing an id
+ * Params:
+ * - element: the id to find
+ * Returns: the id at the root of element's set
+ */
+int DisjointSet::find(int element) {
+    int root = element;
+    while (parents[root] != root) {
+        root = parents[root];
+    }
+    // Compresses the path so each id on it points at the root
+    while (parents[element] != root) {
+        int next = parents[element];
+        parents[element] = root;
+        element = next;
+    }
+    return root;
+}
+
+/**
+ * Merges the sets containing two ids
+ * Params:
+ * - first: an id in the first set
+ * - second: an id in the second set
+ * Returns: true if the sets were merged, false if already the same set
+ */
+bool DisjointSet::unite(int first, int second) {
+    first = find(first);
+    second = find(second);
+    if (first == second) {
+        return false;
+    }
+    if (ranks[first] < ranks[second]) {
+        // Links the shorter uptree under the taller one
+        parents[first] = second;
+    } else if (ranks[first] > ranks[second]) {
+        parents[second] = first;
+    } else {
+        parents[second] = first;
+        ranks[first]++;
+    }
+    numSets--;
+    return true;
+}
+
+/**
+ * Returns the number of disjoint sets
+ * Returns: the number of sets
+ */
+int DisjointSet::getNumSets() { return numSets; }
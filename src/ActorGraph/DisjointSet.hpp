@@ -0,0 +1,61 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the DisjointSet, an
+ * array-based union-find over dense ids.
+ */
+
+#ifndef DISJOINTSET_HPP
+#define DISJOINTSET_HPP
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * This class represents disjoint sets of the ids 0 to size - 1 as uptrees
+ * stored in arrays. Unions link the root of lower rank under the other, and
+ * finds point every id they pass straight at the root, so any sequence of
+ * operations runs in nearly linear time.
+ */
+class DisjointSet {
+  private:
+    vector<int> parents;  // Parent of each id, itself if a root
+    vector<int> ranks;    // Upper bound on the height of each root's uptree
+    int numSets;          // Number of disjoint sets
+
+  public:
+    /**
+     * Constructs sets that each hold a single id
+     * Params:
+     * - size: the number of ids
+     */
+    DisjointSet(int size);
+
+    /**
+     * Returns the root of the set containing an id
+     * Params:
+     * - element: the id to find
+     * Returns: the id at the root of element's set
+     */
+    int find(int element);
+
+    /**
+     * Merges the sets containing two ids
+     * Params:
+     * - first: an id in the first set
+     * - second: an id in the second set
+     * Returns: true if the sets were merged, false if already the same set
+     */
+    bool unite(int first, int second);
+
+    /**
+     * Returns the number of disjoint sets
+     * Returns: the number of sets
+     */
+    int getNumSets();
+};
+
+#endif
@@ -28,10 +28,18 @@ Edge::Edge(Node* srcActor, Node* destActor, Movie movie_name) {
     src = srcActor;
     dest = destActor;
     name = movie_name;
-    weight = 1 + (WEIGHT_YEAR - name.year);
+    weight = weightOfYear(name.year);
     checked = false;
 }
 
+/**
+ * Returns the weight of an edge for a movie made in a given year
+ * Params:
+ * - year: the year of the movie
+ * Returns: the weight, 1 for the newest movies and more for older ones
+ */
+int Edge::weightOfYear(int year) { return 1 + (WEIGHT_YEAR - year); }
+
 /**
  * Updates the weight with newWeight
  * Params:
@@ -52,7 +60,21 @@ int Edge::getWeight() { return weight; }
  * Params: none
  * Returns: name of movie
  */
-Movie Edge::getName() { return name; }
+const Movie& Edge::getName() { return name; }
+
+/**
+ * Returns the year of the movie the two actors starred in
+ * Params: none
+ * Returns: year of movie
+ */
+int Edge::getYear() { return name.year; }
+
+/**
+ * Returns the id of the movie the two actors starred in
+ * Params: none
+ * Returns: id of movie
+ */
+int Edge::getMovieId() { return name.id; }
 
 /**
  * Checks off the node as being checked (usually the backwards of a directed
@@ -74,7 +96,7 @@ bool Edge::isChecked() { return checked; }
  */
 void Edge::unCheck() {
     checked = false;
-    weight = 1 + (WEIGHT_YEAR - name.year);
+    weight = weightOfYear(name.year);
 }
 
 /**
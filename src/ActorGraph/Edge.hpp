@@ -3,6 +3,7 @@
 
 // #include "ActorGraph.hpp"
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -15,6 +16,13 @@
 
 using namespace std;
 class Node;
+class Edge;
+
+// Iterator over a range of a Node's edges
+typedef vector<Edge*>::const_iterator EdgeIter;
+
+// Receives each edge of a spanning forest as soon as it is chosen
+typedef function<void(Edge*)> EdgeSink;
 
 /**
  * This class represents a connection between two actors (represented as nodes)
@@ -41,6 +49,14 @@ class Edge {
      */
     Edge(Node* srcActor, Node* destActor, Movie movieName);
 
+    /**
+     * Returns the weight of an edge for a movie made in a given year
+     * Params:
+     * - year: the year of the movie
+     * Returns: the weight, 1 for the newest movies and more for older ones
+     */
+    static int weightOfYear(int year);
+
     /**
      * Updates the weight with newWeight
      * Params:
@@ -68,7 +84,21 @@ class Edge {
      * starred in
      * Params: none Returns: name of movie
      */
-    Movie getName();
+    const Movie& getName();
+
+    /**
+     * Returns the year of the movie the two actors starred in
+     * Params: none
+     * Returns: year of movie
+     */
+    int getYear();
+
+    /**
+     * Returns the id of the movie the two actors starred in
+     * Params: none
+     * Returns: id of movie
+     */
+    int getMovieId();
 
     /**
      * Returns the node of the actor the edge is directed from
@@ -104,21 +134,22 @@ class Edge {
 
 class Node {
   private:
-    vector<Edge*> edges;  // List of edges connected to this node
-    Edge* prev;           // Path from some node to this node
-    string name;          // Name of actor
+    vector<Edge*> edges;        // List of edges connected to this node
+    vector<Edge*> edgesByYear;  // Edges sorted by year of their movie
+    Edge* prev;                 // Path from some node to this node
+    string name;                // Name of actor
+    int id;                     // Index of actor in its graph
     int pathWeight = MAX_WEIGHT;
     bool done = false;  // True if checked
-    Node* sentinel;     // Sentinel node of Node's subtree
-    Node* base;  // For sentinel node only: pointer to base node of uptree
 
   public:
     /**
      * Constructs a new Node with the name of the actor
      * Params:
      *  - actor_name: the name of the actor
+     *  - actorId: the index of the actor in its graph
      */
-    Node(string actor_name);
+    Node(string actor_name, int actorId = -1);
 
     /**
      * Adds an edge between this actor and another actor, given the movie name
@@ -135,9 +166,12 @@ class Node {
      * pointer to an edge
      * Params:
      * - newEdge: the new connecting edge between this actor node and another
+     * - indexYear: whether to also insert the edge into the year index; if
+     *              false, indexByYear must be called before the next range
+     *              of years is looked up
      * Returns: void
      */
-    void addEdge(Edge* newEdge);
+    void addEdge(Edge* newEdge, bool indexYear = true);
 
     /**
      * Marks a Node as done
@@ -172,32 +206,6 @@ class Node {
      */
     void setStart();
 
-    /**
-     * Retuns the base of the uptree
-     * Returns: the base of the uptree
-     */
-    Node* getBase();
-
-    /**
-     * Sets the base of the uptree to theBase
-     * Params:
-     * - theBase: the base of the uptree of the Node
-     */
-    void setBase(Node* theBase);
-
-    /**
-     * Gets the sentinel Node
-     * Returns: The sentinel node of this Node
-     */
-    Node* getSentinel();
-
-    /**
-     *  Sets the sentinel Node to sent
-     *  Params:
-     *  - sent: the sentinel node
-     */
-    void setSentinel(Node* sent);
-
     /**
      * Sets the path from some other node to this node
      * Params:
@@ -227,7 +235,15 @@ class Node {
      * Params: none
      * Returns: name of actor
      */
-    string getName();
+    const string& getName();
+
+    /**
+     * Returns the index of the actor in its graph, from 0 to the number of
+     * actors - 1
+     * Params: none
+     * Returns: id of actor
+     */
+    int getId();
 
     /**
      * Returns the edge pair connecting the node of this actor and the other
@@ -245,6 +261,26 @@ class Node {
      */
     vector<Edge*> getEdges();
 
+    /**
+     * Sorts a copy of the edges by the year of their movie so that a range of
+     * years can be found by binary search. Called after edges are added
+     * without indexing them, such as when a file is read.
+     * Params: None
+     * Returns: void
+     */
+    void indexByYear();
+
+    /**
+     * Returns the edges whose movies came out between fromYear and toYear
+     * (inclusive). If the range covers every edge, the edges are given in the
+     * order they were added so unrestricted searches are not affected.
+     * Params:
+     * - fromYear: the earliest year of a movie to include
+     * - toYear: the latest year of a movie to include
+     * Returns: a pair of iterators bounding the edges in the range
+     */
+    pair<EdgeIter, EdgeIter> getEdgesInYears(int fromYear, int toYear) const;
+
     /**
      * Destructor for Node, frees all edges
      * Params: None
@@ -0,0 +1,102 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the parallel
+ * counting sort of edges by weight.
+ */
+
+#include <algorithm>
+
+#include "EdgeSort.hpp"
+#include "Workers.hpp"
+
+/**
+ * Runs one stable counting pass, ordering edges by a digit of their weight
+ * Params:
+ * - input: the edges to order
+ * - output: filled with the ordered edges, same size as input
+ * - minWeight: the weight subtracted before taking the digit
+ * - shift: the number of low bits below the digit
+ * - numBuckets: the number of values the digit can take
+ * - numThreads: the number of threads to use
+ * Returns: void
+ */
+static void countingPass(vector<Edge*>& input, vector<Edge*>& output,
+                         int minWeight, int shift, int numBuckets,
+                         int numThreads) {
+    long chunk = (input.size() + numThreads - 1) / numThreads;
+    vector<vector<long>> counts(numThreads, vector<long>(numBuckets, 0));
+    auto digit = [minWeight, shift, numBuckets](Edge* edge) {
+        return (((long)edge->getWeight() - minWeight) >> shift) &
+               (numBuckets - 1);
+    };
+
+    // Each thread counts the digits in its chunk
+    runWorkers(numThreads, [&](int part) {
+        long last = min((long)input.size(), (part + 1) * chunk);
+        for (long edge = part * chunk; edge < last; edge++) {
+            counts[part][digit(input[edge])]++;
+        }
+    });
+
+    // Turns the counts into where each thread writes each digit: all lower
+    // digits come first, then the same digit from earlier chunks
+    long offset = 0;
+    for (int bucket = 0; bucket < numBuckets; bucket++) {
+        for (int part = 0; part < numThreads; part++) {
+            long count = counts[part][bucket];
+            counts[part][bucket] = offset;
+            offset += count;
+        }
+    }
+
+    runWorkers(numThreads, [&](int part) {
+        long last = min((long)input.size(), (part + 1) * chunk);
+        for (long edge = part * chunk; edge < last; edge++) {
+            output[counts[part][digit(input[edge])]++] = input[edge];
+        }
+    });
+}
+
+/**
+ * Sorts edges from lowest to highest weight in linear time. Edge weights are
+ * small integers, so one stable counting pass over the range of weights is
+ * usually enough; wider ranges are sorted RADIX_BITS at a time from the
+ * lowest digit up. Each pass splits the edges into one contiguous chunk per
+ * thread: threads count their chunk, the counts are turned into offsets,
+ * then each thread scatters its chunk into place.
+ * Params:
+ * - edges: the edges to sort, replaced by the sorted edges
+ * - numThreads: the number of threads to sort with
+ * Returns: void
+ */
+void sortEdgesByWeight(vector<Edge*>& edges, int numThreads) {
+    if (edges.size() < 2) {
+        return;
+    }
+    numThreads = max(1, numThreads);
+    int minWeight = edges[0]->getWeight();
+    int maxWeight = edges[0]->getWeight();
+    for (long edge = 1; edge < (long)edges.size(); edge++) {
+        minWeight = min(minWeight, edges[edge]->getWeight());
+        maxWeight = max(maxWeight, edges[edge]->getWeight());
+    }
+    long range = (long)maxWeight - minWeight;
+    if (range == 0) {
+        // Every edge has the same weight
+        return;
+    }
+
+    // Smallest power of two of buckets holding the range, up to RADIX_BITS
+    int bits = 0;
+    while (bits < RADIX_BITS && (range >> bits) > 0) {
+        bits++;
+    }
+    vector<Edge*> buffer(edges.size());
+    for (int shift = 0; shift == 0 || (range >> shift) > 0; shift += bits) {
+        countingPass(edges, buffer, minWeight, shift, 1 << bits, numThreads);
+        edges.swap(buffer);
+    }
+}
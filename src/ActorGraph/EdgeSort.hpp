@@ -0,0 +1,36 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the parallel counting
+ * sort that orders edges by weight for Kruskal's algorithm.
+ */
+
+#ifndef EDGESORT_HPP
+#define EDGESORT_HPP
+
+#include <vector>
+
+#include "Edge.hpp"
+
+using namespace std;
+
+// Number of bits of the weight sorted by each counting pass
+#define RADIX_BITS 16
+
+/**
+ * Sorts edges from lowest to highest weight in linear time. Edge weights are
+ * small integers, so one stable counting pass over the range of weights is
+ * usually enough; wider ranges are sorted RADIX_BITS at a time from the
+ * lowest digit up. Each pass splits the edges into one contiguous chunk per
+ * thread: threads count their chunk, the counts are turned into offsets,
+ * then each thread scatters its chunk into place.
+ * Params:
+ * - edges: the edges to sort, replaced by the sorted edges
+ * - numThreads: the number of threads to sort with
+ * Returns: void
+ */
+void sortEdgesByWeight(vector<Edge*>& edges, int numThreads);
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the ExclusionMask,
+ * which marks actors and movies that a path query has to avoid.
+ */
+
+#include "ExclusionMask.hpp"
+
+/**
+ * Constructs an empty mask over a graph
+ * Params:
+ * - numActors: the number of actor ids in the graph
+ * - numMovies: the number of movie ids in the graph
+ */
+ExclusionMask::ExclusionMask(int numActors, int numMovies)
+    : actorBits(numActors / BITS_PER_WORD + 1, 0),
+      movieBits(numMovies / BITS_PER_WORD + 1, 0) {}
+
+/**
+ * Excludes an actor from the paths
+ * Params:
+ * - actorId: the id of the actor to avoid
+ * Returns: void
+ */
+void ExclusionMask::excludeActor(int actorId) {
+    actorBits[actorId / BITS_PER_WORD] |= (uint64_t)1
+                                          << (actorId % BITS_PER_WORD);
+    excludedActors.push_back(actorId);
+}
+
+/**
+ * Excludes a movie from the paths
+ * Params:
+ * - movieId: the id of the movie to avoid
+ * Returns: void
+ */
+void ExclusionMask::excludeMovie(int movieId) {
+    movieBits[movieId / BITS_PER_WORD] |= (uint64_t)1
+                                          << (movieId % BITS_PER_WORD);
+    excludedMovies.push_back(movieId);
+}
+
+/**
+ * Removes every exclusion so the mask can be reused
+ * Params: None
+ * Returns: void
+ */
+void ExclusionMask::clear() {
+    // Only the words that were set need to be zeroed
+    for (int actor = 0; actor < (int)excludedActors.size(); actor++) {
+        actorBits[excludedActors[actor] / BITS_PER_WORD] = 0;
+    }
+    for (int movie = 0; movie < (int)excludedMovies.size(); movie++) {
+        movieBits[excludedMovies[movie] / BITS_PER_WORD] = 0;
+    }
+    excludedActors.clear();
+    excludedMovies.clear();
+}
+
+/**
+ * Returns if nothing is excluded
+ * Returns: true if no actor or movie is excluded
+ */
+bool ExclusionMask::isEmpty() {
+    return excludedActors.empty() && excludedMovies.empty();
+}
@@ -0,0 +1,113 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the ExclusionMask, a pair
+ * of bitsets over actor and movie ids that searches consult to skip actors or
+ * movies without modifying the graph.
+ */
+
+#ifndef EXCLUSIONMASK_HPP
+#define EXCLUSIONMASK_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Edge.hpp"
+
+using namespace std;
+
+// Number of ids stored in each word of a bitset
+#define BITS_PER_WORD 64
+
+/**
+ * This class represents the actors and movies a query must avoid, as one bit
+ * per actor id and one bit per movie id. The ids that were excluded are also
+ * kept in a list, so a mask can be cleared and reused for the next query in
+ * time proportional to what it excluded rather than to the size of the graph.
+ */
+class ExclusionMask {
+  private:
+    vector<uint64_t> actorBits;  // Bit per actor id, set if excluded
+    vector<uint64_t> movieBits;  // Bit per movie id, set if excluded
+    vector<int> excludedActors;  // Ids of excluded actors
+    vector<int> excludedMovies;  // Ids of excluded movies
+
+  public:
+    /**
+     * Constructs an empty mask over a graph
+     * Params:
+     * - numActors: the number of actor ids in the graph
+     * - numMovies: the number of movie ids in the graph
+     */
+    ExclusionMask(int numActors, int numMovies);
+
+    /**
+     * Excludes an actor from the paths
+     * Params:
+     * - actorId: the id of the actor to avoid
+     * Returns: void
+     */
+    void excludeActor(int actorId);
+
+    /**
+     * Excludes a movie from the paths
+     * Params:
+     * - movieId: the id of the movie to avoid
+     * Returns: void
+     */
+    void excludeMovie(int movieId);
+
+    /**
+     * Removes every exclusion so the mask can be reused
+     * Params: None
+     * Returns: void
+     */
+    void clear();
+
+    /**
+     * Returns if nothing is excluded
+     * Returns: true if no actor or movie is excluded
+     */
+    bool isEmpty();
+
+    /**
+     * Returns if an actor is excluded. Defined here so searches can check
+     * every edge without a function call.
+     * Params:
+     * - actorId: the id of the actor
+     * Returns: true if the actor is excluded
+     */
+    bool excludesActor(int actorId) {
+        return (actorBits[actorId / BITS_PER_WORD] >>
+                (actorId % BITS_PER_WORD)) &
+               1;
+    }
+
+    /**
+     * Returns if a movie is excluded
+     * Params:
+     * - movieId: the id of the movie
+     * Returns: true if the movie is excluded
+     */
+    bool excludesMovie(int movieId) {
+        return (movieBits[movieId / BITS_PER_WORD] >>
+                (movieId % BITS_PER_WORD)) &
+               1;
+    }
+
+    /**
+     * Returns if a search may not follow an edge, because its movie or the
+     * actor it leads to is excluded
+     * Params:
+     * - edge: the edge about to be followed
+     * Returns: true if the edge must be skipped
+     */
+    bool excludes(Edge* edge) {
+        return excludesMovie(edge->getMovieId()) ||
+               excludesActor(edge->getDest()->getId());
+    }
+};
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the external memory
+ * minimum spanning forest.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <queue>
+
+#include "DisjointSet.hpp"
+#include "ExternalMST.hpp"
+
+/**
+ * Compares records by weight
+ * Params:
+ * - lhs: the left hand side record
+ * - rhs: the right hand side record
+ * Returns: true if lhs is lighter than rhs
+ */
+static bool lighter(const EdgeRecord& lhs, const EdgeRecord& rhs) {
+    return lhs.weight < rhs.weight;
+}
+
+/**
+ * This struct reads one sorted run back from its file a block at a time
+ */
+struct RunReader {
+    FILE* file;                  // The run's temporary file
+    vector<EdgeRecord> records;  // The block being read
+    size_t next;                 // Index of the next record in the block
+
+    /**
+     * Reads the next block of the run
+     * Params: None
+     * Returns: false if the run is finished, otherwise true
+     */
+    bool refill() {
+        records.resize(records.capacity());
+        size_t read = fread(records.data(), sizeof(EdgeRecord),
+                            records.size(), file);
+        records.resize(read);
+        next = 0;
+        return read > 0;
+    }
+};
+
+/**
+ * Sorts the buffer of records and writes it to a new temporary file
+ * Params:
+ * - buffer: the records, emptied afterwards
+ * - runs: the files of the runs so far, to which the new one is added
+ * Returns: false if the run could not be written, otherwise true
+ */
+static bool writeRun(vector<EdgeRecord>& buffer, vector<FILE*>& runs) {
+    sort(buffer.begin(), buffer.end(), lighter);
+    FILE* file = tmpfile();
+    if (!file) {
+        return false;
+    }
+    runs.push_back(file);
+    if (fwrite(buffer.data(), sizeof(EdgeRecord), buffer.size(), file) !=
+        buffer.size()) {
+        return false;
+    }
+    rewind(file);
+    buffer.clear();
+    return true;
+}
+
+/**
+ * Opens a reader over each run and reads its first block
+ * Params:
+ * - runs: the files of the runs
+ * - readRecords: the most records to read from a run at a time
+ * Returns: the readers, in the order of runs
+ */
+static vector<RunReader> openReaders(const vector<FILE*>& runs,
+                                     size_t readRecords) {
+    vector<RunReader> readers(runs.size());
+    for (int run = 0; run < (int)runs.size(); run++) {
+        readers[run].file = runs[run];
+        readers[run].records.reserve(readRecords);
+        readers[run].refill();
+    }
+    return readers;
+}
+
+/**
+ * Merges the runs of the readers, handing their records to consume from
+ * lowest to highest weight
+ * Params:
+ * - readers: the readers, each with its first block read
+ * - consume: receives each record, and returns false to stop the merge
+ * Returns: void
+ */
+static void mergeReaders(vector<RunReader>& readers,
+                         function<bool(const EdgeRecord&)> consume) {
+    typedef pair<int, int> Head;  // Weight of a run's next record and the run
+    priority_queue<Head, vector<Head>, greater<Head>> heads;
+    for (int run = 0; run < (int)readers.size(); run++) {
+        if (!readers[run].records.empty()) {
+            heads.push({readers[run].records[0].weight, run});
+        }
+    }
+    while (!heads.empty()) {
+        RunReader& reader = readers[heads.top().second];
+        heads.pop();
+        if (!consume(reader.records[reader.next++])) {
+            return;
+        }
+        if (reader.next < reader.records.size() || reader.refill()) {
+            heads.push({reader.records[reader.next].weight,
+                        (int)(&reader - readers.data())});
+        }
+    }
+}
+
+/**
+ * Merges each group of fanIn consecutive runs into one longer run, reading
+ * and writing a block of MIN_READ_RECORDS records at a time
+ * Params:
+ * - runs: the files of the runs, replaced by those of the merged runs
+ * - fanIn: the most runs merged into one
+ * Returns: false if a merged run could not be written, otherwise true
+ */
+static bool mergeRuns(vector<FILE*>& runs, size_t fanIn) {
+    vector<FILE*> merged;
+    vector<EdgeRecord> block;
+    block.reserve(MIN_READ_RECORDS);
+    bool written = true;
+    for (size_t first = 0; first < runs.size(); first += fanIn) {
+        vector<FILE*> group(runs.begin() + first,
+                            runs.begin() + min(runs.size(), first + fanIn));
+        FILE* file = written ? tmpfile() : nullptr;
+        if (file) {
+            merged.push_back(file);
+            vector<RunReader> readers = openReaders(group, MIN_READ_RECORDS);
+            mergeReaders(readers, [&](const EdgeRecord& record) {
+                block.push_back(record);
+                if (block.size() == MIN_READ_RECORDS) {
+                    written = fwrite(block.data(), sizeof(EdgeRecord),
+                                     block.size(), file) == block.size();
+                    block.clear();
+                }
+                return written;
+            });
+            if (written && fwrite(block.data(), sizeof(EdgeRecord),
+                                  block.size(), file) != block.size()) {
+                written = false;
+            }
+            block.clear();
+            rewind(file);
+        } else {
+            written = false;
+        }
+        for (FILE* run : group) {
+            fclose(run);
+        }
+    }
+    runs = merged;
+    return written;
+}
+
+/**
+ * Finds the Edge a record was made from
+ * Params:
+ * - graph: the graph of all actors
+ * - record: the record
+ * Returns: the edge from the record's source to its dest in its movie, or
+ *          nullptr if the graph has no such edge
+ */
+Edge* findRecordEdge(ActorGraph& graph, const EdgeRecord& record) {
+    int year = graph.getMovieById(record.movie).year;
+    pair<EdgeIter, EdgeIter> range =
+        graph.getActorById(record.source)->getEdgesInYears(year, year);
+    for (EdgeIter edge = range.first; edge != range.second; edge++) {
+        if ((*edge)->getDest()->getId() == record.dest &&
+            (*edge)->getMovieId() == record.movie) {
+            return *edge;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Finds a minimum spanning forest without ever holding all the edges in
+ * memory. One record per pair of costars is generated from each movie's cast
+ * into a buffer of memoryBudget bytes, and each full buffer is sorted by
+ * weight and written to a temporary file as a run. While there are more runs
+ * than blocks of MIN_READ_RECORDS fit in the budget, groups of runs are
+ * merged into longer ones, so the final merge can read each run through its
+ * share of the budget. The merged stream feeds Kruskal's algorithm with an
+ * in-memory union-find over actor ids. A budget below the three blocks a
+ * merge needs is raised to them. Only the casts of the graph are read, never
+ * its Edges.
+ * Params:
+ * - graph: the graph of all actors
+ * - component: the connected component to span, or -1 for every component
+ * - memoryBudget: the most bytes of records to hold in memory at once
+ * - sink: receives each record of the forest as it is chosen, from lowest
+ *         to highest weight
+ * - workBytes: if not nullptr, set to the peak bytes of the working arrays
+ * - numRuns: if not nullptr, set to the number of sorted runs written,
+ *            before any were merged
+ * Returns: false if the runs could not be written, in which case sink was
+ *          given nothing, otherwise true
+ */
+bool findExternalForest(ActorGraph& graph, int component, size_t memoryBudget,
+                        RecordSink sink, size_t* workBytes, int* numRuns) {
+    size_t bufferRecords =
+        max((size_t)MIN_READ_RECORDS, memoryBudget / sizeof(EdgeRecord));
+    vector<EdgeRecord> buffer;
+    vector<FILE*> runs;
+    bool written = true;
+
+    // Writes the costars of every movie as sorted runs
+    for (int movieId = 0; movieId < graph.getNumMovies() && written;
+         movieId++) {
+        Movie movie = graph.getMovieById(movieId);
+        vector<Node*> cast = graph.getMovieCast(movie);
+        if (cast.size() < 2 ||
+            (component != -1 && graph.getComponent(cast[0]) != component)) {
+            continue;
+        }
+        int weight = Edge::weightOfYear(movie.year);
+        for (int first = 0; first < (int)cast.size() && written; first++) {
+            for (int second = first + 1; second < (int)cast.size(); second++) {
+                int source = cast[first]->getId();
+                int dest = cast[second]->getId();
+                if (buffer.size() == buffer.capacity()) {
+                    // Grows without passing the budget
+                    buffer.reserve(
+                        min(bufferRecords, max((size_t)MIN_READ_RECORDS,
+                                               2 * buffer.capacity())));
+                }
+                buffer.push_back({weight, min(source, dest),
+                                  max(source, dest), movieId});
+                if (buffer.size() == bufferRecords &&
+                    !(written = writeRun(buffer, runs))) {
+                    break;
+                }
+            }
+        }
+    }
+    if (written && !buffer.empty()) {
+        written = writeRun(buffer, runs);
+    }
+    size_t peakRecords = buffer.capacity();
+    int numSorted = runs.size();
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    // Merges groups of runs, keeping a block to write the merged run to,
+    // until each run left gets a block of the final merge
+    size_t budgetBlocks = bufferRecords / MIN_READ_RECORDS;
+    size_t mergeRecords = 0;
+    while (written && runs.size() > max((size_t)2, budgetBlocks)) {
+        size_t fanIn = max((size_t)2, budgetBlocks - 1);
+        mergeRecords = (fanIn + 1) * MIN_READ_RECORDS;
+        written = mergeRuns(runs, fanIn);
+    }
+
+    // Merges the runs, each read through an equal share of the budget
+    size_t readRecords =
+        min(peakRecords, max((size_t)MIN_READ_RECORDS,
+                             bufferRecords / max((size_t)1, runs.size())));
+    vector<RunReader> readers =
+        openReaders(written ? runs : vector<FILE*>(), readRecords);
+    DisjointSet uptrees(graph.getNumActors());
+    int target = component == -1
+                     ? graph.getNumActors() - graph.getNumComponents()
+                     : graph.getComponentSizes()[component] - 1;
+    int numChosen = 0;
+    if (target > 0) {
+        mergeReaders(readers, [&](const EdgeRecord& record) {
+            if (uptrees.unite(record.source, record.dest)) {
+                numChosen++;
+                sink(record);
+            }
+            return numChosen < target;
+        });
+    }
+
+    for (int run = 0; run < (int)runs.size(); run++) {
+        fclose(runs[run]);
+    }
+    if (workBytes) {
+        *workBytes = max(max(peakRecords, mergeRecords),
+                         readRecords * readers.size()) *
+                         sizeof(EdgeRecord) +
+                     graph.getNumActors() * 2 * sizeof(int);
+    }
+    if (numRuns) {
+        *numRuns = numSorted;
+    }
+    return written;
+}
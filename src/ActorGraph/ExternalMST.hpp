@@ -0,0 +1,75 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the external memory
+ * minimum spanning forest, which sorts edges in runs on disk.
+ */
+
+#ifndef EXTERNALMST_HPP
+#define EXTERNALMST_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+// Fewest records read from a run at a time while merging, and the size of
+// the blocks runs are merged in
+#define MIN_READ_RECORDS 256
+
+/**
+ * A compact undirected edge, written to disk in place of an Edge
+ */
+struct EdgeRecord {
+    int weight;  // Weight of the edge
+    int source;  // Id of the actor with the lower id
+    int dest;    // Id of the other actor
+    int movie;   // Id of the movie they share
+};
+
+// Receives each record of a spanning forest as it is chosen
+typedef function<void(const EdgeRecord&)> RecordSink;
+
+/**
+ * Finds the Edge a record was made from
+ * Params:
+ * - graph: the graph of all actors
+ * - record: the record
+ * Returns: the edge from the record's source to its dest in its movie, or
+ *          nullptr if the graph has no such edge
+ */
+Edge* findRecordEdge(ActorGraph& graph, const EdgeRecord& record);
+
+/**
+ * Finds a minimum spanning forest without ever holding all the edges in
+ * memory. One record per pair of costars is generated from each movie's cast
+ * into a buffer of memoryBudget bytes, and each full buffer is sorted by
+ * weight and written to a temporary file as a run. While there are more runs
+ * than blocks of MIN_READ_RECORDS fit in the budget, groups of runs are
+ * merged into longer ones, so the final merge can read each run through its
+ * share of the budget. The merged stream feeds Kruskal's algorithm with an
+ * in-memory union-find over actor ids. A budget below the three blocks a
+ * merge needs is raised to them. Only the casts of the graph are read, never
+ * its Edges.
+ * Params:
+ * - graph: the graph of all actors
+ * - component: the connected component to span, or -1 for every component
+ * - memoryBudget: the most bytes of records to hold in memory at once
+ * - sink: receives each record of the forest as it is chosen, from lowest
+ *         to highest weight
+ * - workBytes: if not nullptr, set to the peak bytes of the working arrays
+ * - numRuns: if not nullptr, set to the number of sorted runs written,
+ *            before any were merged
+ * Returns: false if the runs could not be written, in which case sink was
+ *          given nothing, otherwise true
+ */
+bool findExternalForest(ActorGraph& graph, int component, size_t memoryBudget,
+                        RecordSink sink, size_t* workBytes = nullptr,
+                        int* numRuns = nullptr);
+
+#endif
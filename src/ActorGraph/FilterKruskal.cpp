@@ -0,0 +1,118 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Osipov, Sanders and Singler, "The Filter-Kruskal Minimum Spanning
+ * Tree Algorithm"
+ * Description: This file contains the implementation for Filter-Kruskal.
+ */
+
+#include <algorithm>
+
+#include "DisjointSet.hpp"
+#include "FilterKruskal.hpp"
+
+/**
+ * Compares edges by weight
+ * Params:
+ * - lhs: the left hand side Edge
+ * - rhs: the right hand side Edge
+ * Returns: true if lhs is lighter than rhs
+ */
+static bool lighter(Edge* lhs, Edge* rhs) {
+    return lhs->getWeight() < rhs->getWeight();
+}
+
+/**
+ * Adds the edges of a range that join two sets, in order
+ * Params:
+ * - first: the first edge of the range
+ * - last: one past the last edge of the range
+ * - uptrees: the sets of connected actors
+ * - sink: receives the chosen edges
+ * Returns: void
+ */
+static void addEdges(vector<Edge*>::iterator first,
+                     vector<Edge*>::iterator last, DisjointSet& uptrees,
+                     EdgeSink& sink) {
+    for (; first != last && uptrees.getNumSets() > 1; first++) {
+        if (uptrees.unite((*first)->getSource()->getId(),
+                          (*first)->getDest()->getId())) {
+            sink(*first);
+        }
+    }
+}
+
+/**
+ * Runs Filter-Kruskal on a range of edges, all heavier than every edge
+ * already handled
+ * Params:
+ * - first: the first edge of the range
+ * - last: one past the last edge of the range
+ * - uptrees: the sets of connected actors
+ * - sink: receives the chosen edges
+ * Returns: void
+ */
+static void filterKruskal(vector<Edge*>::iterator first,
+                          vector<Edge*>::iterator last, DisjointSet& uptrees,
+                          EdgeSink& sink) {
+    if (last - first <= FILTER_CUTOFF) {
+        sort(first, last, lighter);
+        addEdges(first, last, uptrees, sink);
+        return;
+    }
+
+    // Median of three weights as the pivot
+    int weights[] = {(*first)->getWeight(),
+                     (*(first + (last - first) / 2))->getWeight(),
+                     (*(last - 1))->getWeight()};
+    sort(weights, weights + 3);
+    int pivot = weights[1];
+
+    // Splits into lighter, equal and heavier than the pivot. Weights repeat a
+    // lot, so keeping equal edges apart makes every split shrink the range.
+    vector<Edge*>::iterator equal = partition(
+        first, last, [pivot](Edge* edge) { return edge->getWeight() < pivot; });
+    vector<Edge*>::iterator heavier = partition(
+        equal, last, [pivot](Edge* edge) { return edge->getWeight() == pivot; });
+
+    filterKruskal(first, equal, uptrees, sink);
+    addEdges(equal, heavier, uptrees, sink);
+    if (uptrees.getNumSets() == 1) {
+        return;
+    }
+
+    // Drops heavier edges that would only close a cycle
+    vector<Edge*>::iterator kept =
+        partition(heavier, last, [&uptrees](Edge* edge) {
+            return uptrees.find(edge->getSource()->getId()) !=
+                   uptrees.find(edge->getDest()->getId());
+        });
+    filterKruskal(heavier, kept, uptrees, sink);
+}
+
+/**
+ * Finds a minimum spanning forest with Filter-Kruskal. The edges are split
+ * around a pivot weight into lighter, equal and heavier edges. The lighter
+ * edges are handled first, recursively, then the equal ones in any order.
+ * Heavier edges whose actors are by then already connected are filtered out
+ * before the heavier range is split in turn, so in a graph made of movie
+ * cliques most edges are discarded in a linear scan instead of being sorted.
+ * Params:
+ * - edges: the undirected edges of the graph, each given once; reordered
+ * - numActors: the number of actor ids
+ * - sink: if set, receives each edge as it is chosen instead of the edges
+ *         being returned
+ * Returns: the edges of the minimum spanning forest, from lowest to highest
+ *          weight, or nothing if sink is set
+ */
+vector<Edge*> findFilterKruskalForest(vector<Edge*>& edges, int numActors,
+                                      EdgeSink sink) {
+    DisjointSet uptrees(numActors);
+    vector<Edge*> forest;
+    if (!sink) {
+        sink = [&forest](Edge* edge) { forest.push_back(edge); };
+    }
+    filterKruskal(edges.begin(), edges.end(), uptrees, sink);
+    return forest;
+}
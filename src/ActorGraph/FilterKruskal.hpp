@@ -0,0 +1,41 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Osipov, Sanders and Singler, "The Filter-Kruskal Minimum Spanning
+ * Tree Algorithm"
+ * Description: This file contains the declaration of Filter-Kruskal, which
+ * finds a minimum spanning forest without sorting most redundant edges.
+ */
+
+#ifndef FILTERKRUSKAL_HPP
+#define FILTERKRUSKAL_HPP
+
+#include <vector>
+
+#include "Edge.hpp"
+
+using namespace std;
+
+// Ranges of at most this many edges are sorted instead of partitioned
+#define FILTER_CUTOFF 1024
+
+/**
+ * Finds a minimum spanning forest with Filter-Kruskal. The edges are split
+ * around a pivot weight into lighter, equal and heavier edges. The lighter
+ * edges are handled first, recursively, then the equal ones in any order.
+ * Heavier edges whose actors are by then already connected are filtered out
+ * before the heavier range is split in turn, so in a graph made of movie
+ * cliques most edges are discarded in a linear scan instead of being sorted.
+ * Params:
+ * - edges: the undirected edges of the graph, each given once; reordered
+ * - numActors: the number of actor ids
+ * - sink: if set, receives each edge as it is chosen instead of the edges
+ *         being returned
+ * Returns: the edges of the minimum spanning forest, from lowest to highest
+ *          weight, or nothing if sink is set
+ */
+vector<Edge*> findFilterKruskalForest(vector<Edge*>& edges, int numActors,
+                                      EdgeSink sink = nullptr);
+
+#endif
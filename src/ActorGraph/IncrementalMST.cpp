@@ -0,0 +1,99 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the IncrementalMST.
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include "IncrementalMST.hpp"
+
+// Value of actor vertices, below every edge weight
+#define ACTOR_VALUE INT_MIN
+
+/**
+ * Constructs a forest with no actors
+ */
+IncrementalMST::IncrementalMST() : numEdges(0), totalWeight(0) {}
+
+/**
+ * Adds an edge to the graph, updating the forest. Actors are added to the
+ * forest the first time they are seen.
+ * Params:
+ * - edge: the new edge
+ * Returns: true if the forest changed, false if the edge was dropped
+ */
+bool IncrementalMST::addEdge(Edge* edge) {
+    int source = edge->getSource()->getId();
+    int dest = edge->getDest()->getId();
+    while ((int)actorVertex.size() <= max(source, dest)) {
+        actorVertex.push_back(forest.addVertex(ACTOR_VALUE));
+        edgeOf.push_back(nullptr);
+    }
+    int sourceVertex = actorVertex[source];
+    int destVertex = actorVertex[dest];
+
+    if (forest.connected(sourceVertex, destVertex)) {
+        int heaviest = forest.findHeaviest(sourceVertex, destVertex);
+        if (forest.getValue(heaviest) <= edge->getWeight()) {
+            // Would be the heaviest edge of a cycle
+            return false;
+        }
+        // Replaces the heaviest edge on the cycle
+        Edge* replaced = edgeOf[heaviest];
+        forest.cut(heaviest, actorVertex[replaced->getSource()->getId()]);
+        forest.cut(heaviest, actorVertex[replaced->getDest()->getId()]);
+        edgeOf[heaviest] = nullptr;
+        freeVertices.push_back(heaviest);
+        numEdges--;
+        totalWeight -= replaced->getWeight();
+    }
+
+    int vertex;
+    if (freeVertices.empty()) {
+        vertex = forest.addVertex(edge->getWeight());
+        edgeOf.push_back(nullptr);
+    } else {
+        vertex = freeVertices.back();
+        freeVertices.pop_back();
+        forest.setValue(vertex, edge->getWeight());
+    }
+    edgeOf[vertex] = edge;
+    forest.link(vertex, sourceVertex);
+    forest.link(vertex, destVertex);
+    numEdges++;
+    totalWeight += edge->getWeight();
+    return true;
+}
+
+/**
+ * Returns the edges in the forest
+ * Params: None
+ * Returns: a vector of the forest edges
+ */
+vector<Edge*> IncrementalMST::getEdges() {
+    vector<Edge*> edges;
+    for (int vertex = 0; vertex < (int)edgeOf.size(); vertex++) {
+        if (edgeOf[vertex]) {
+            edges.push_back(edgeOf[vertex]);
+        }
+    }
+    return edges;
+}
+
+/**
+ * Returns the number of edges in the forest
+ * Params: None
+ * Returns: the number of edges
+ */
+int IncrementalMST::getNumEdges() { return numEdges; }
+
+/**
+ * Returns the total weight of the forest
+ * Params: None
+ * Returns: the sum of the weights of the forest edges
+ */
+long IncrementalMST::getWeight() { return totalWeight; }
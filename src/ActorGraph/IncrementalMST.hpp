@@ -0,0 +1,74 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the IncrementalMST, a
+ * minimum spanning forest that is updated as edges are added.
+ */
+
+#ifndef INCREMENTALMST_HPP
+#define INCREMENTALMST_HPP
+
+#include <vector>
+
+#include "Edge.hpp"
+#include "LinkCutTree.hpp"
+
+using namespace std;
+
+/**
+ * This class keeps a minimum spanning forest of a growing graph in a
+ * LinkCutTree. Each forest edge is a vertex of the LinkCutTree between its two
+ * actors, valued by its weight, while actors are valued below any weight, so
+ * the heaviest vertex on a path is its heaviest edge. By the cycle property, a
+ * new edge between connected actors replaces the heaviest edge on the path
+ * between them if it is lighter, and is dropped otherwise.
+ */
+class IncrementalMST {
+  private:
+    LinkCutTree forest;       // Actors and forest edges as vertices
+    vector<int> actorVertex;  // LinkCutTree vertex of each actor id
+    vector<Edge*> edgeOf;     // Forest edge of each vertex, nullptr if none
+    vector<int> freeVertices; // Vertices of edges that were replaced
+    int numEdges;             // Number of edges in the forest
+    long totalWeight;         // Sum of the weights of the forest edges
+
+  public:
+    /**
+     * Constructs a forest with no actors
+     */
+    IncrementalMST();
+
+    /**
+     * Adds an edge to the graph, updating the forest. Actors are added to the
+     * forest the first time they are seen.
+     * Params:
+     * - edge: the new edge
+     * Returns: true if the forest changed, false if the edge was dropped
+     */
+    bool addEdge(Edge* edge);
+
+    /**
+     * Returns the edges in the forest
+     * Params: None
+     * Returns: a vector of the forest edges
+     */
+    vector<Edge*> getEdges();
+
+    /**
+     * Returns the number of edges in the forest
+     * Params: None
+     * Returns: the number of edges
+     */
+    int getNumEdges();
+
+    /**
+     * Returns the total weight of the forest
+     * Params: None
+     * Returns: the sum of the weights of the forest edges
+     */
+    long getWeight();
+};
+
+#endif
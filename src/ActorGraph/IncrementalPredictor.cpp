@@ -0,0 +1,145 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the
+ * IncrementalPredictor.
+ */
+
+#include <algorithm>
+
+#include "IncrementalPredictor.hpp"
+#include "LinkPredictor.hpp"
+
+/**
+ * Predicts both lists of every actor in a graph
+ * Params:
+ * - graph: the graph of all actors
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads to use
+ */
+IncrementalPredictor::IncrementalPredictor(ActorGraph& graph, int fromYear,
+                                           int toYear, int k, int numThreads)
+    : graph(graph),
+      fromYear(fromYear),
+      toYear(toYear),
+      k(k),
+      matrix(graph, fromYear, toYear),
+      nameRanks(graph.getNameRanks()),
+      collabs(graph.getNumActors()),
+      uncollabs(graph.getNumActors()),
+      isAffected(graph.getNumActors(), false) {
+    vector<int> actors(graph.getNumActors());
+    for (int actor = 0; actor < (int)actors.size(); actor++) {
+        actors[actor] = actor;
+    }
+    predictActors(actors, numThreads);
+}
+
+/**
+ * Predicts both lists of actors again with predictIdsParallel
+ * Params:
+ * - actors: the ids of the actors
+ * - numThreads: the number of threads to use
+ * Returns: void
+ */
+void IncrementalPredictor::predictActors(const vector<int>& actors,
+                                         int numThreads) {
+    if (actors.empty()) {
+        return;
+    }
+    vector<vector<int>> actorCollabs;
+    vector<vector<int>> actorUncollabs;
+    // A small update is not worth a thread per core
+    predictIdsParallel(graph, matrix, nameRanks, k, actors, WEIGHTED_MODEL,
+                       min(numThreads, (int)actors.size()), actorCollabs,
+                       actorUncollabs);
+    for (int query = 0; query < (int)actors.size(); query++) {
+        collabs[actors[query]] = move(actorCollabs[query]);
+        uncollabs[actors[query]] = move(actorUncollabs[query]);
+    }
+}
+
+/**
+ * Updates the lists after edges were added to the graph, such as those
+ * returned by ActorGraph::addFromFile
+ * Params:
+ * - newEdges: one edge per new pair of costars
+ * - numThreads: the number of threads to use
+ * Returns: the number of actors predicted again
+ */
+int IncrementalPredictor::addEdges(const vector<Edge*>& newEdges,
+                                   int numThreads) {
+    vector<RowEntry> additions;
+    vector<int> costars;  // Actors of the counted new edges
+    for (Edge* edge : newEdges) {
+        int source = edge->getSource()->getId();
+        int dest = edge->getDest()->getId();
+        if (source == dest || edge->getYear() < fromYear ||
+            edge->getYear() > toYear) {
+            continue;
+        }
+        additions.push_back({source, {dest, 1}});
+        additions.push_back({dest, {source, 1}});
+        costars.push_back(source);
+        costars.push_back(dest);
+    }
+
+    // New actors get empty rows and lists, and every actor a new name rank
+    int numActors = graph.getNumActors();
+    if (numActors > matrix.getNumRows()) {
+        nameRanks = graph.getNameRanks();
+        collabs.resize(numActors);
+        uncollabs.resize(numActors);
+        isAffected.resize(numActors, false);
+    }
+    matrix.addEntries(numActors, additions);
+
+    // The costars and, since they are the middle of their paths, every
+    // collaborator of theirs
+    sort(costars.begin(), costars.end());
+    costars.erase(unique(costars.begin(), costars.end()), costars.end());
+    vector<int> affected;
+    for (int costar : costars) {
+        if (!isAffected[costar]) {
+            isAffected[costar] = true;
+            affected.push_back(costar);
+        }
+        const int* columns = matrix.getColumns(costar);
+        int length = matrix.getRowLength(costar);
+        for (int entry = 0; entry < length; entry++) {
+            if (!isAffected[columns[entry]]) {
+                isAffected[columns[entry]] = true;
+                affected.push_back(columns[entry]);
+            }
+        }
+    }
+    predictActors(affected, numThreads);
+    for (int actor : affected) {
+        isAffected[actor] = false;
+    }
+    return affected.size();
+}
+
+/**
+ * Returns the top collaborators of an actor
+ * Params:
+ * - actor: the id of the actor
+ * Returns: their ids, best first
+ */
+const vector<int>& IncrementalPredictor::getCollabs(int actor) {
+    return collabs[actor];
+}
+
+/**
+ * Returns the top actors two steps away from an actor
+ * Params:
+ * - actor: the id of the actor
+ * Returns: their ids, best first
+ */
+const vector<int>& IncrementalPredictor::getUncollabs(int actor) {
+    return uncollabs[actor];
+}
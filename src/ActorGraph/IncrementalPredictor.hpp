@@ -0,0 +1,92 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the IncrementalPredictor,
+ * which keeps both predicted lists of every actor up to date as movies are
+ * added.
+ */
+
+#ifndef INCREMENTALPREDICTOR_HPP
+#define INCREMENTALPREDICTOR_HPP
+
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "CollabMatrix.hpp"
+#include "Edge.hpp"
+
+using namespace std;
+
+/**
+ * This class keeps both weighted lists of every actor, and the
+ * CollabMatrix they are predicted from, as edges are added to the graph. A
+ * candidate u's score for actor a is the sum over shared collaborators n of
+ * A[a][n] * A[n][u], so adding to A[x][y] only changes the scores of x and
+ * y themselves and, through them, the scores of their collaborators. Only
+ * those actors are predicted again, so a new movie costs its cast and their
+ * collaborators instead of every actor in the graph.
+ */
+class IncrementalPredictor {
+  private:
+    ActorGraph& graph;               // The graph of all actors
+    int fromYear;                    // Earliest year of a movie counted
+    int toYear;                      // Latest year of a movie counted
+    int k;                           // Actors predicted in each list
+    CollabMatrix matrix;             // Movies shared by each pair of actors
+    vector<int> nameRanks;           // Alphabetical rank of each actor
+    vector<vector<int>> collabs;     // Top collaborators of each actor id
+    vector<vector<int>> uncollabs;   // Top new actors of each actor id
+    vector<bool> isAffected;         // Whether each id is to be predicted
+
+    /**
+     * Predicts both lists of actors again with predictIdsParallel
+     * Params:
+     * - actors: the ids of the actors
+     * - numThreads: the number of threads to use
+     * Returns: void
+     */
+    void predictActors(const vector<int>& actors, int numThreads);
+
+  public:
+    /**
+     * Predicts both lists of every actor in a graph
+     * Params:
+     * - graph: the graph of all actors
+     * - fromYear: the earliest year of a movie to count
+     * - toYear: the latest year of a movie to count
+     * - k: the number of actors to predict in each list
+     * - numThreads: the number of threads to use
+     */
+    IncrementalPredictor(ActorGraph& graph, int fromYear, int toYear, int k,
+                         int numThreads);
+
+    /**
+     * Updates the lists after edges were added to the graph, such as those
+     * returned by ActorGraph::addFromFile
+     * Params:
+     * - newEdges: one edge per new pair of costars
+     * - numThreads: the number of threads to use
+     * Returns: the number of actors predicted again
+     */
+    int addEdges(const vector<Edge*>& newEdges, int numThreads);
+
+    /**
+     * Returns the top collaborators of an actor
+     * Params:
+     * - actor: the id of the actor
+     * Returns: their ids, best first
+     */
+    const vector<int>& getCollabs(int actor);
+
+    /**
+     * Returns the top actors two steps away from an actor
+     * Params:
+     * - actor: the id of the actor
+     * Returns: their ids, best first
+     */
+    const vector<int>& getUncollabs(int actor);
+};
+
+#endif
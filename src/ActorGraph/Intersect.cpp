@@ -0,0 +1,321 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Lemire, Boytsov and Kurz, "SIMD Compression and the Intersection
+ * of Sorted Integers"; Schlegel, Willhalm and Lehner, "Fast Sorted-Set
+ * Intersection using SIMD Instructions"
+ * Description: This file contains the implementation of the kernels that
+ * intersect sorted arrays of actor ids.
+ */
+
+#include <algorithm>
+
+#include "Intersect.hpp"
+
+// The block kernels need x86 intrinsics and GCC style target attributes
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_INTERSECT
+#include <immintrin.h>
+
+/**
+ * Records the shared ids of a block given which of its lanes matched
+ * Params:
+ * - mask: one bit per lane of the block in first, set if it matched
+ * - position: the position in first of the block's first lane
+ * - matches: filled with the positions in first of the shared ids, or null
+ * - count: the number of shared ids so far, increased by the matches
+ * Returns: void
+ */
+static inline void addMatches(unsigned int mask, int position, int* matches,
+                              int& count) {
+    if (!matches) {
+        count += __builtin_popcount(mask);
+        return;
+    }
+    while (mask) {
+        matches[count++] = position + __builtin_ctz(mask);
+        mask &= mask - 1;
+    }
+}
+#endif
+
+/**
+ * Intersects two sorted arrays by merging them one element at a time,
+ * starting from given positions
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - next: the position in first to start from
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - other: the position in second to start from
+ * - matches: filled with the positions in first of the shared ids, or null
+ * - count: the number of shared ids so far, increased by the matches
+ * Returns: void
+ */
+static void mergeFrom(const int* first, int firstLength, int next,
+                      const int* second, int secondLength, int other,
+                      int* matches, int& count) {
+    while (next < firstLength && other < secondLength) {
+        if (first[next] < second[other]) {
+            next++;
+        } else if (second[other] < first[next]) {
+            other++;
+        } else {
+            if (matches) {
+                matches[count] = next;
+            }
+            count++;
+            next++;
+            other++;
+        }
+    }
+}
+
+/**
+ * Intersects two sorted arrays by merging them one element at a time
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectMerge(const int* first, int firstLength, const int* second,
+                   int secondLength, int* matches) {
+    int count = 0;
+    mergeFrom(first, firstLength, 0, second, secondLength, 0, matches, count);
+    return count;
+}
+
+/**
+ * Returns the first position from start on whose id is at least a target,
+ * doubling the step until it is passed, then binary searching the last step
+ * Params:
+ * - ids: a sorted array
+ * - length: the length of the array
+ * - start: the position to search from
+ * - target: the id to search for
+ * Returns: the position, or length if every id from start is smaller
+ */
+static int gallop(const int* ids, int length, int start, int target) {
+    int step = 1;
+    int low = start;
+    int high = start;
+    while (high < length && ids[high] < target) {
+        low = high + 1;
+        high = start + step;
+        step *= 2;
+    }
+    high = min(high, length);
+    return lower_bound(ids + low, ids + high, target) - ids;
+}
+
+/**
+ * Intersects two sorted arrays by looking each id of the shorter one up in
+ * the longer one, searching exponentially forward from the last match, so
+ * the time grows with the shorter array times the log of the size ratio
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectGallop(const int* first, int firstLength, const int* second,
+                    int secondLength, int* matches) {
+    int count = 0;
+    if (firstLength <= secondLength) {
+        int other = 0;
+        for (int next = 0; next < firstLength; next++) {
+            other = gallop(second, secondLength, other, first[next]);
+            if (other == secondLength) {
+                break;
+            }
+            if (second[other] == first[next]) {
+                if (matches) {
+                    matches[count] = next;
+                }
+                count++;
+            }
+        }
+    } else {
+        int next = 0;
+        for (int other = 0; other < secondLength; other++) {
+            next = gallop(first, firstLength, next, second[other]);
+            if (next == firstLength) {
+                break;
+            }
+            if (first[next] == second[other]) {
+                if (matches) {
+                    matches[count] = next;
+                }
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Intersects two sorted arrays by merging blocks of four ids, comparing
+ * every pair in a block at once with SSE2. Falls back to intersectMerge
+ * where SSE2 is not available.
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectSSE(const int* first, int firstLength, const int* second,
+                 int secondLength, int* matches) {
+    int count = 0;
+    int next = 0;
+    int other = 0;
+#ifdef SIMD_INTERSECT
+    while (next + 4 <= firstLength && other + 4 <= secondLength) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(first + next));
+        __m128i otherBlock = _mm_loadu_si128((const __m128i*)(second + other));
+        // Compares against every rotation of the other block
+        __m128i equal = _mm_cmpeq_epi32(block, otherBlock);
+        equal = _mm_or_si128(
+            equal, _mm_cmpeq_epi32(block, _mm_shuffle_epi32(otherBlock, 0x39)));
+        equal = _mm_or_si128(
+            equal, _mm_cmpeq_epi32(block, _mm_shuffle_epi32(otherBlock, 0x4e)));
+        equal = _mm_or_si128(
+            equal, _mm_cmpeq_epi32(block, _mm_shuffle_epi32(otherBlock, 0x93)));
+        addMatches(_mm_movemask_ps(_mm_castsi128_ps(equal)), next, matches,
+                   count);
+        // Moves past whichever block ends first, or both
+        int last = first[next + 3];
+        int otherLast = second[other + 3];
+        if (last <= otherLast) {
+            next += 4;
+        }
+        if (otherLast <= last) {
+            other += 4;
+        }
+    }
+#endif
+    mergeFrom(first, firstLength, next, second, secondLength, other, matches,
+              count);
+    return count;
+}
+
+#ifdef SIMD_INTERSECT
+/**
+ * Intersects two sorted arrays by merging blocks of eight ids, comparing
+ * every pair in a block at once with AVX2. Must only be called when
+ * hasAVX2() is true.
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+__attribute__((target("avx2"))) int intersectAVX2(const int* first,
+                                                  int firstLength,
+                                                  const int* second,
+                                                  int secondLength,
+                                                  int* matches) {
+    int count = 0;
+    int next = 0;
+    int other = 0;
+    __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while (next + 8 <= firstLength && other + 8 <= secondLength) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(first + next));
+        __m256i otherBlock =
+            _mm256_loadu_si256((const __m256i*)(second + other));
+        // Compares against every rotation of the other block
+        __m256i equal = _mm256_cmpeq_epi32(block, otherBlock);
+        for (int turn = 1; turn < 8; turn++) {
+            otherBlock = _mm256_permutevar8x32_epi32(otherBlock, rotate);
+            equal =
+                _mm256_or_si256(equal, _mm256_cmpeq_epi32(block, otherBlock));
+        }
+        addMatches(_mm256_movemask_ps(_mm256_castsi256_ps(equal)), next,
+                   matches, count);
+        // Moves past whichever block ends first, or both
+        int last = first[next + 7];
+        int otherLast = second[other + 7];
+        if (last <= otherLast) {
+            next += 8;
+        }
+        if (otherLast <= last) {
+            other += 8;
+        }
+    }
+    mergeFrom(first, firstLength, next, second, secondLength, other, matches,
+              count);
+    return count;
+}
+
+/**
+ * Returns whether the processor running the program supports AVX2
+ * Params: None
+ * Returns: true if intersectAVX2 may be called
+ */
+bool hasAVX2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#else
+/**
+ * Intersects two sorted arrays, by merging since AVX2 is not available
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectAVX2(const int* first, int firstLength, const int* second,
+                  int secondLength, int* matches) {
+    return intersectMerge(first, firstLength, second, secondLength, matches);
+}
+
+/**
+ * Returns whether the processor running the program supports AVX2
+ * Params: None
+ * Returns: false, the kernel is not built here
+ */
+bool hasAVX2() { return false; }
+#endif
+
+/**
+ * Intersects two sorted arrays with the kernel best suited to their sizes:
+ * galloping when one is at least GALLOP_RATIO times longer, otherwise the
+ * widest block merge the processor supports
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersect(const int* first, int firstLength, const int* second,
+              int secondLength, int* matches) {
+    int shorter = min(firstLength, secondLength);
+    int longer = max(firstLength, secondLength);
+    if (shorter == 0) {
+        return 0;
+    }
+    if (longer / shorter >= GALLOP_RATIO) {
+        return intersectGallop(first, firstLength, second, secondLength,
+                               matches);
+    }
+    if (hasAVX2()) {
+        return intersectAVX2(first, firstLength, second, secondLength,
+                             matches);
+    }
+    return intersectSSE(first, firstLength, second, secondLength, matches);
+}
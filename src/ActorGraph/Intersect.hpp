@@ -0,0 +1,107 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Lemire, Boytsov and Kurz, "SIMD Compression and the Intersection
+ * of Sorted Integers"; Schlegel, Willhalm and Lehner, "Fast Sorted-Set
+ * Intersection using SIMD Instructions"
+ * Description: This file contains the declaration of the kernels that
+ * intersect sorted arrays of actor ids, such as the rows of a CollabMatrix.
+ */
+
+#ifndef INTERSECT_HPP
+#define INTERSECT_HPP
+
+using namespace std;
+
+// Size ratio from which the smaller array is galloped through the larger
+#define GALLOP_RATIO 16
+
+/*
+ * Every kernel takes two strictly increasing arrays and returns how many ids
+ * they share. If matches is not null, it is filled with the positions in the
+ * first array of the shared ids, in increasing order, and must have room for
+ * the length of the shorter array.
+ */
+
+/**
+ * Intersects two sorted arrays by merging them one element at a time
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectMerge(const int* first, int firstLength, const int* second,
+                   int secondLength, int* matches);
+
+/**
+ * Intersects two sorted arrays by looking each id of the shorter one up in
+ * the longer one, searching exponentially forward from the last match, so
+ * the time grows with the shorter array times the log of the size ratio
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectGallop(const int* first, int firstLength, const int* second,
+                    int secondLength, int* matches);
+
+/**
+ * Intersects two sorted arrays by merging blocks of four ids, comparing
+ * every pair in a block at once with SSE2. Falls back to intersectMerge
+ * where SSE2 is not available.
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectSSE(const int* first, int firstLength, const int* second,
+                 int secondLength, int* matches);
+
+/**
+ * Intersects two sorted arrays by merging blocks of eight ids, comparing
+ * every pair in a block at once with AVX2. Must only be called when
+ * hasAVX2() is true.
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersectAVX2(const int* first, int firstLength, const int* second,
+                  int secondLength, int* matches);
+
+/**
+ * Returns whether the processor running the program supports AVX2
+ * Params: None
+ * Returns: true if intersectAVX2 may be called
+ */
+bool hasAVX2();
+
+/**
+ * Intersects two sorted arrays with the kernel best suited to their sizes:
+ * galloping when one is at least GALLOP_RATIO times longer, otherwise the
+ * widest block merge the processor supports
+ * Params:
+ * - first: the first array
+ * - firstLength: the length of the first array
+ * - second: the second array
+ * - secondLength: the length of the second array
+ * - matches: filled with the positions in first of the shared ids, or null
+ * Returns: the number of shared ids
+ */
+int intersect(const int* first, int firstLength, const int* second,
+              int secondLength, int* matches);
+
+#endif
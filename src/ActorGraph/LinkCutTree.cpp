@@ -0,0 +1,269 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Sleator and Tarjan, "A Data Structure for Dynamic Trees"
+ * Description: This file contains the implementation for the LinkCutTree.
+ */
+
+#include <algorithm>
+
+#include "LinkCutTree.hpp"
+
+/**
+ * Constructs a forest with no vertices
+ */
+LinkCutTree::LinkCutTree() {}
+
+/**
+ * Returns whether a vertex is the root of its splay tree
+ * Params:
+ * - vertex: the vertex
+ * Returns: true if its parent is missing or a path parent
+ */
+bool LinkCutTree::isSplayRoot(int vertex) {
+    int parent = parents[vertex];
+    return parent == NO_VERTEX ||
+           (lefts[parent] != vertex && rights[parent] != vertex);
+}
+
+/**
+ * Recomputes the heaviest vertex of a splay subtree from its children
+ * Params:
+ * - vertex: the root of the subtree
+ * Returns: void
+ */
+void LinkCutTree::update(int vertex) {
+    heaviest[vertex] = vertex;
+    int children[] = {lefts[vertex], rights[vertex]};
+    for (int child : children) {
+        if (child != NO_VERTEX &&
+            values[heaviest[child]] > values[heaviest[vertex]]) {
+            heaviest[vertex] = heaviest[child];
+        }
+    }
+}
+
+/**
+ * Swaps the children of a vertex if a reversal is pending and passes the
+ * reversal on to them
+ * Params:
+ * - vertex: the vertex
+ * Returns: void
+ */
+void LinkCutTree::pushDown(int vertex) {
+    if (!flipped[vertex]) {
+        return;
+    }
+    swap(lefts[vertex], rights[vertex]);
+    if (lefts[vertex] != NO_VERTEX) {
+        flipped[lefts[vertex]] = !flipped[lefts[vertex]];
+    }
+    if (rights[vertex] != NO_VERTEX) {
+        flipped[rights[vertex]] = !flipped[rights[vertex]];
+    }
+    flipped[vertex] = false;
+}
+
+/**
+ * Rotates a vertex above its splay parent
+ * Params:
+ * - vertex: the vertex
+ * Returns: void
+ */
+void LinkCutTree::rotate(int vertex) {
+    int parent = parents[vertex];
+    int grandparent = parents[parent];
+    if (!isSplayRoot(parent)) {
+        if (lefts[grandparent] == parent) {
+            lefts[grandparent] = vertex;
+        } else {
+            rights[grandparent] = vertex;
+        }
+    }
+    parents[vertex] = grandparent;
+
+    if (lefts[parent] == vertex) {
+        lefts[parent] = rights[vertex];
+        if (rights[vertex] != NO_VERTEX) {
+            parents[rights[vertex]] = parent;
+        }
+        rights[vertex] = parent;
+    } else {
+        rights[parent] = lefts[vertex];
+        if (lefts[vertex] != NO_VERTEX) {
+            parents[lefts[vertex]] = parent;
+        }
+        lefts[vertex] = parent;
+    }
+    parents[parent] = vertex;
+    update(parent);
+    update(vertex);
+}
+
+/**
+ * Moves a vertex to the root of its splay tree
+ * Params:
+ * - vertex: the vertex
+ * Returns: void
+ */
+void LinkCutTree::splay(int vertex) {
+    // Pending reversals are pushed down from the splay root first
+    vector<int> path = {vertex};
+    for (int current = vertex; !isSplayRoot(current);
+         current = parents[current]) {
+        path.push_back(parents[current]);
+    }
+    for (int index = path.size() - 1; index >= 0; index--) {
+        pushDown(path[index]);
+    }
+
+    while (!isSplayRoot(vertex)) {
+        int parent = parents[vertex];
+        if (!isSplayRoot(parent)) {
+            int grandparent = parents[parent];
+            bool zigZig = (lefts[grandparent] == parent) ==
+                          (lefts[parent] == vertex);
+            rotate(zigZig ? parent : vertex);
+        }
+        rotate(vertex);
+    }
+}
+
+/**
+ * Makes the path from the root of a vertex's tree to the vertex preferred,
+ * leaving the vertex at the root of its splay tree
+ * Params:
+ * - vertex: the vertex
+ * Returns: void
+ */
+void LinkCutTree::access(int vertex) {
+    int last = NO_VERTEX;
+    for (int current = vertex; current != NO_VERTEX;
+         current = parents[current]) {
+        splay(current);
+        rights[current] = last;
+        update(current);
+        last = current;
+    }
+    splay(vertex);
+}
+
+/**
+ * Makes a vertex the root of its tree
+ * Params:
+ * - vertex: the vertex
+ * Returns: void
+ */
+void LinkCutTree::makeRoot(int vertex) {
+    access(vertex);
+    flipped[vertex] = !flipped[vertex];
+}
+
+/**
+ * Returns the root of a vertex's tree
+ * Params:
+ * - vertex: the vertex
+ * Returns: the root vertex
+ */
+int LinkCutTree::findRoot(int vertex) {
+    access(vertex);
+    int root = vertex;
+    pushDown(root);
+    while (lefts[root] != NO_VERTEX) {
+        root = lefts[root];
+        pushDown(root);
+    }
+    splay(root);
+    return root;
+}
+
+/**
+ * Adds a vertex that is a tree by itself
+ * Params:
+ * - value: the value of the vertex
+ * Returns: the id of the new vertex
+ */
+int LinkCutTree::addVertex(int value) {
+    parents.push_back(NO_VERTEX);
+    lefts.push_back(NO_VERTEX);
+    rights.push_back(NO_VERTEX);
+    flipped.push_back(false);
+    values.push_back(value);
+    heaviest.push_back(values.size() - 1);
+    return values.size() - 1;
+}
+
+/**
+ * Changes the value of a vertex that is a tree by itself
+ * Params:
+ * - vertex: the vertex
+ * - value: the new value
+ * Returns: void
+ */
+void LinkCutTree::setValue(int vertex, int value) {
+    access(vertex);
+    values[vertex] = value;
+    update(vertex);
+}
+
+/**
+ * Returns the value of a vertex
+ * Params:
+ * - vertex: the vertex
+ * Returns: its value
+ */
+int LinkCutTree::getValue(int vertex) { return values[vertex]; }
+
+/**
+ * Returns whether two vertices are in the same tree
+ * Params:
+ * - first: a vertex
+ * - second: another vertex
+ * Returns: true if there is a path between them
+ */
+bool LinkCutTree::connected(int first, int second) {
+    return first == second || findRoot(first) == findRoot(second);
+}
+
+/**
+ * Joins two trees with an edge between two vertices
+ * Params:
+ * - first: a vertex in one tree
+ * - second: a vertex in another tree
+ * Returns: void
+ */
+void LinkCutTree::link(int first, int second) {
+    makeRoot(first);
+    parents[first] = second;
+}
+
+/**
+ * Removes the edge between two adjacent vertices
+ * Params:
+ * - first: a vertex
+ * - second: a vertex adjacent to it
+ * Returns: void
+ */
+void LinkCutTree::cut(int first, int second) {
+    makeRoot(first);
+    access(second);
+    // first is now the only vertex shallower than second on the path
+    lefts[second] = NO_VERTEX;
+    parents[first] = NO_VERTEX;
+    update(second);
+}
+
+/**
+ * Returns the heaviest vertex on the path between two vertices of the same
+ * tree, ends included
+ * Params:
+ * - first: a vertex
+ * - second: a vertex in the same tree
+ * Returns: the vertex with the largest value on the path
+ */
+int LinkCutTree::findHeaviest(int first, int second) {
+    makeRoot(first);
+    access(second);
+    return heaviest[second];
+}
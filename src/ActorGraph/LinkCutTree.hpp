@@ -0,0 +1,171 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Sleator and Tarjan, "A Data Structure for Dynamic Trees"
+ * Description: This file contains the declaration of the LinkCutTree, a forest
+ * that can link and cut trees and find the heaviest vertex on a path.
+ */
+
+#ifndef LINKCUTTREE_HPP
+#define LINKCUTTREE_HPP
+
+#include <vector>
+
+using namespace std;
+
+// Marks a missing child or parent
+#define NO_VERTEX -1
+
+/**
+ * This class represents a forest of unrooted trees over the vertices 0 to
+ * size - 1, each with a value. Every preferred path is kept in a splay tree
+ * ordered by depth that also tracks its heaviest vertex, so linking, cutting
+ * and finding the heaviest vertex between two vertices take amortized
+ * logarithmic time.
+ */
+class LinkCutTree {
+  private:
+    vector<int> parents;    // Splay parent, or path parent of a splay root
+    vector<int> lefts;      // Shallower child in the splay tree
+    vector<int> rights;     // Deeper child in the splay tree
+    vector<bool> flipped;   // Whether the children still need to be swapped
+    vector<int> values;     // Value of each vertex
+    vector<int> heaviest;   // Heaviest vertex in each splay subtree
+
+    /**
+     * Returns whether a vertex is the root of its splay tree
+     * Params:
+     * - vertex: the vertex
+     * Returns: true if its parent is missing or a path parent
+     */
+    bool isSplayRoot(int vertex);
+
+    /**
+     * Recomputes the heaviest vertex of a splay subtree from its children
+     * Params:
+     * - vertex: the root of the subtree
+     * Returns: void
+     */
+    void update(int vertex);
+
+    /**
+     * Swaps the children of a vertex if a reversal is pending and passes the
+     * reversal on to them
+     * Params:
+     * - vertex: the vertex
+     * Returns: void
+     */
+    void pushDown(int vertex);
+
+    /**
+     * Rotates a vertex above its splay parent
+     * Params:
+     * - vertex: the vertex
+     * Returns: void
+     */
+    void rotate(int vertex);
+
+    /**
+     * Moves a vertex to the root of its splay tree
+     * Params:
+     * - vertex: the vertex
+     * Returns: void
+     */
+    void splay(int vertex);
+
+    /**
+     * Makes the path from the root of a vertex's tree to the vertex preferred,
+     * leaving the vertex at the root of its splay tree
+     * Params:
+     * - vertex: the vertex
+     * Returns: void
+     */
+    void access(int vertex);
+
+    /**
+     * Makes a vertex the root of its tree
+     * Params:
+     * - vertex: the vertex
+     * Returns: void
+     */
+    void makeRoot(int vertex);
+
+    /**
+     * Returns the root of a vertex's tree
+     * Params:
+     * - vertex: the vertex
+     * Returns: the root vertex
+     */
+    int findRoot(int vertex);
+
+  public:
+    /**
+     * Constructs a forest with no vertices
+     */
+    LinkCutTree();
+
+    /**
+     * Adds a vertex that is a tree by itself
+     * Params:
+     * - value: the value of the vertex
+     * Returns: the id of the new vertex
+     */
+    int addVertex(int value);
+
+    /**
+     * Changes the value of a vertex that is a tree by itself
+     * Params:
+     * - vertex: the vertex
+     * - value: the new value
+     * Returns: void
+     */
+    void setValue(int vertex, int value);
+
+    /**
+     * Returns the value of a vertex
+     * Params:
+     * - vertex: the vertex
+     * Returns: its value
+     */
+    int getValue(int vertex);
+
+    /**
+     * Returns whether two vertices are in the same tree
+     * Params:
+     * - first: a vertex
+     * - second: another vertex
+     * Returns: true if there is a path between them
+     */
+    bool connected(int first, int second);
+
+    /**
+     * Joins two trees with an edge between two vertices
+     * Params:
+     * - first: a vertex in one tree
+     * - second: a vertex in another tree
+     * Returns: void
+     */
+    void link(int first, int second);
+
+    /**
+     * Removes the edge between two adjacent vertices
+     * Params:
+     * - first: a vertex
+     * - second: a vertex adjacent to it
+     * Returns: void
+     */
+    void cut(int first, int second);
+
+    /**
+     * Returns the heaviest vertex on the path between two vertices of the same
+     * tree, ends included
+     * Params:
+     * - first: a vertex
+     * - second: a vertex in the same tree
+     * Returns: the vertex with the largest value on the path
+     */
+    int findHeaviest(int first, int second);
+};
+
+#endif
@@ -0,0 +1,778 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Gilbert, Moler and Schreiber, "Sparse Matrices in MATLAB: Design
+ * and Implementation"; Liben-Nowell and Kleinberg, "The Link Prediction
+ * Problem for Social Networks"
+ * Description: This file contains the implementation for the LinkPredictor.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+
+#include "Intersect.hpp"
+#include "LinkPredictor.hpp"
+#include "Workers.hpp"
+
+/**
+ * Returns the number of a scoring model given its name
+ * Params:
+ * - name: the name of the model
+ * Returns: the number of the model, or -1 if there is no such model
+ */
+int findModel(const string& name) {
+    for (int model = 0; model < NUM_MODELS; model++) {
+        if (name == MODEL_NAMES[model]) {
+            return model;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Returns the names of actors given their ids
+ * Params:
+ * - graph: the graph of all actors
+ * - ids: the ids of the actors
+ * Returns: the names, in the same order
+ */
+vector<string> getNames(ActorGraph& graph, const vector<int>& ids) {
+    vector<string> names;
+    for (int id : ids) {
+        names.push_back(graph.getActorById(id)->getName());
+    }
+    return names;
+}
+
+/**
+ * Returns the score of a candidate by intersecting its row of the matrix with
+ * the actor's: the sum, over their shared collaborators, of the movies the
+ * actor made with that collaborator times the movies it made with the
+ * candidate
+ * Params:
+ * - matrix: the collaboration matrix
+ * - actor: the id of the actor
+ * - candidate: the id of the candidate
+ * - direct: the movies each id made with the actor
+ * - matches: room for the positions of the shared collaborators
+ * Returns: the score of the candidate
+ */
+int scoreByIntersection(CollabMatrix& matrix, int actor, int candidate,
+                        const vector<int>& direct, vector<int>& matches) {
+    const int* columns = matrix.getColumns(candidate);
+    const int* values = matrix.getValues(candidate);
+    matches.resize(
+        min(matrix.getRowLength(candidate), matrix.getRowLength(actor)));
+    int shared = intersect(columns, matrix.getRowLength(candidate),
+                           matrix.getColumns(actor), matrix.getRowLength(actor),
+                           matches.data());
+    int score = 0;
+    for (int match = 0; match < shared; match++) {
+        score += values[matches[match]] * direct[columns[matches[match]]];
+    }
+    return score;
+}
+
+/**
+ * Returns the score of a pair of actors under a model, scored like the
+ * LinkPredictor scores a candidate, from the intersection of their rows of
+ * the matrix alone, so the time grows with the sum of their numbers of
+ * collaborators rather than with the actor's two step neighborhood
+ * Params:
+ * - matrix: the collaboration matrix
+ * - model: the number of the model
+ * - actor: the id of one actor
+ * - other: the id of the other actor
+ * - matches: room for the positions of the shared collaborators in the
+ *   actor's row
+ * - otherMatches: room for their positions in the other actor's row
+ * Returns: the score of the pair
+ */
+double scorePair(CollabMatrix& matrix, int model, int actor, int other,
+                 vector<int>& matches, vector<int>& otherMatches) {
+    const int* columns = matrix.getColumns(actor);
+    const int* values = matrix.getValues(actor);
+    int length = matrix.getRowLength(actor);
+    const int* otherColumns = matrix.getColumns(other);
+    const int* otherValues = matrix.getValues(other);
+    int otherLength = matrix.getRowLength(other);
+    if (model == PREFERENTIAL_MODEL) {
+        return (double)length * otherLength;
+    }
+
+    // Both intersections list the shared collaborators in order of id, so
+    // their positions line up
+    matches.resize(min(length, otherLength));
+    otherMatches.resize(min(length, otherLength));
+    int shared = intersect(columns, length, otherColumns, otherLength,
+                           matches.data());
+    if (model != COMMON_MODEL && model != JACCARD_MODEL) {
+        intersect(otherColumns, otherLength, columns, length,
+                  otherMatches.data());
+    }
+    double sum = 0;
+    for (int match = 0; match < shared; match++) {
+        int middle = columns[matches[match]];
+        int numCostars = matrix.getRowLength(middle);
+        switch (model) {
+            case ADAMIC_ADAR_MODEL:
+                sum += numCostars > 1 ? 1 / log(numCostars) : 0;
+                break;
+            case RESOURCE_MODEL:
+                sum += 1.0 / numCostars;
+                break;
+            case COMMON_MODEL:
+            case JACCARD_MODEL:
+                break;
+            default:
+                sum += (double)values[matches[match]] *
+                       otherValues[otherMatches[match]];
+        }
+    }
+    switch (model) {
+        case COMMON_MODEL:
+            return shared;
+        case JACCARD_MODEL:
+            return shared ? (double)shared / (length + otherLength - shared)
+                          : 0;
+        case KATZ_MODEL: {
+            const int* found = lower_bound(columns, columns + length, other);
+            int movies = found != columns + length && *found == other
+                             ? values[found - columns]
+                             : 0;
+            return KATZ_BETA * movies + KATZ_BETA * KATZ_BETA * sum;
+        }
+        default:
+            return sum;
+    }
+}
+
+/**
+ * Predicts the top k actors that are most likely to be in the next movie
+ * with actor out of those who already collaborated with the actor
+ * Params:
+ * - graph: the graph of all actors
+ * - actorName: name of actor to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict
+ * Returns: top k actors in next movie (out of collaborators), or none if
+ *          the actor is not in the graph
+ */
+vector<string> predictCollaborate(ActorGraph& graph, string actorName,
+                                  int fromYear, int toYear,
+                                  const vector<int>& nameRanks, int k) {
+    Node* actor = graph.getActorNode(actorName);
+    if (!actor) {
+        return {};
+    }
+    pair<EdgeIter, EdgeIter> edges = actor->getEdgesInYears(fromYear, toYear);
+    unordered_map<Node*, int> collaborators;
+    // Finds all collaborators and number of movies both are in
+    for (EdgeIter edge = edges.first; edge != edges.second; edge++) {
+        if (collaborators.find((*edge)->getDest()) == collaborators.end()) {
+            // collaborator not in map
+            collaborators.insert({(*edge)->getDest(), 1});
+            continue;
+        }
+        collaborators[(*edge)->getDest()]++;
+    }
+    TopKSelector closest(nameRanks, k);
+
+    // Loops through each collaborator in order to calculate their priority
+    for (auto iter = collaborators.begin(); iter != collaborators.end();
+         iter++) {
+        pair<EdgeIter, EdgeIter> neighbors =
+            iter->first->getEdgesInYears(fromYear, toYear);
+        unordered_map<Node*, int> neighborMap;
+        // sorts through all outgoing edges of neighbor node to find number of
+        // edges between each neighbor and current actor
+        for (EdgeIter edge = neighbors.first; edge != neighbors.second;
+             edge++) {
+            if (collaborators.find((*edge)->getDest()) == collaborators.end() ||
+                (*edge)->getDest() == iter->first) {
+                // neighbor not a collaborator or itself
+                continue;
+            }
+            if (neighborMap.find((*edge)->getDest()) == neighborMap.end()) {
+                // edge between collaborator and neighbor not in list
+                neighborMap[(*edge)->getDest()] = 1;
+
+            } else {
+                neighborMap[(*edge)->getDest()]++;
+            }
+        }
+        int priority = 0;
+        // Goes through neighbors to calculate priority
+        for (auto iter2 = neighborMap.begin(); iter2 != neighborMap.end();
+             iter2++) {
+            // numEdges from actor to collab * numEdges from collab to current
+            priority += (collaborators[iter2->first] * iter2->second);
+        }
+        closest.offer(priority, iter->first->getId());
+    }
+    // Only the names of the top actors are looked up
+    return getNames(graph, closest.takeTop());
+}
+
+/**
+ * Predicts the top k actors that are most likely to be in the next movie
+ * with actor out of those who haven't collaborated with the actor
+ * Params:
+ * - graph: the graph of all actors
+ * - actorName: name of actor to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict
+ * Returns: top k actors in next movie (out of non-collaborators), or none if
+ *          the actor is not in the graph
+ */
+vector<string> predictNew(ActorGraph& graph, string actorName, int fromYear,
+                          int toYear, const vector<int>& nameRanks, int k) {
+    Node* actor = graph.getActorNode(actorName);
+    if (!actor) {
+        return {};
+    }
+    pair<EdgeIter, EdgeIter> edges = actor->getEdgesInYears(fromYear, toYear);
+    unordered_map<Node*, int> collaborators;
+    // Finds all collaborators and number of movies both are in
+    for (EdgeIter edge = edges.first; edge != edges.second; edge++) {
+        if (collaborators.find((*edge)->getDest()) == collaborators.end()) {
+            // collaborator not in map
+            collaborators.insert({(*edge)->getDest(), 1});
+            continue;
+        }
+        collaborators[(*edge)->getDest()]++;
+    }
+    unordered_map<Node*, int>
+        noncollabs;  // one degree of separation apart from actor
+
+    // Loops through each collaborator to find all actors that are one degree
+    // apart
+    for (auto iter = collaborators.begin(); iter != collaborators.end();
+         iter++) {
+        pair<EdgeIter, EdgeIter> neighbors =
+            iter->first->getEdgesInYears(fromYear, toYear);
+        // Loops through each edge to create list of non-collaborators
+        for (EdgeIter edge = neighbors.first; edge != neighbors.second;
+             edge++) {
+            if (collaborators.find((*edge)->getDest()) == collaborators.end() &&
+                (*edge)->getDest() != actor) {
+                // if the edge from the collaborator is not another collaborator
+                // nor the original actor
+                if (noncollabs.find((*edge)->getDest()) == noncollabs.end()) {
+                    // noncollaborator not in hashmap yet
+                    noncollabs[(*edge)->getDest()] = 0;
+                }
+            }
+        }
+    }
+
+    // Loops through each noncollaborator to calculate its priority
+    for (auto iter = noncollabs.begin(); iter != noncollabs.end(); iter++) {
+        pair<EdgeIter, EdgeIter> neighbors =
+            iter->first->getEdgesInYears(fromYear, toYear);
+        unordered_map<Node*, int> priorities;
+        // Loops through each edge to find number of edges shared with a
+        // collaborator
+        for (EdgeIter edge = neighbors.first; edge != neighbors.second;
+             edge++) {
+            if (collaborators.find((*edge)->getDest()) != collaborators.end()) {
+                // Edge is with a collaborator
+                if (priorities.find((*edge)->getDest()) == priorities.end()) {
+                    // collaborator not in list
+                    priorities[(*edge)->getDest()] = 1;
+                } else {
+                    priorities[(*edge)->getDest()]++;
+                }
+            }
+        }
+        // Calculates total priority of noncollaborator
+        int priority = 0;
+        for (auto iter2 = priorities.begin(); iter2 != priorities.end();
+             iter2++) {
+            // For each collab, find product between actor and collab and collab
+            // and curr
+            priority +=
+                (collaborators.find(iter2->first)->second * iter2->second);
+        }
+        iter->second = priority;
+    }
+
+    TopKSelector allNoncollabs(nameRanks, k);
+    for (auto iter = noncollabs.begin(); iter != noncollabs.end(); iter++) {
+        allNoncollabs.offer(iter->second, iter->first->getId());
+    }
+    // Only the names of the top actors are looked up
+    return getNames(graph, allNoncollabs.takeTop());
+}
+
+/**
+ * Constructs a predictor for a graph
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph
+ * - nameRanks: the alphabetical rank of each actor's name
+ * - k: the number of actors to predict in each list
+ * - limits: bounds on the work of each prediction
+ */
+LinkPredictor::LinkPredictor(ActorGraph& graph, CollabMatrix& matrix,
+                             const vector<int>& nameRanks, int k,
+                             WorkLimits limits)
+    : graph(graph),
+      matrix(matrix),
+      sums((size_t)matrix.getNumRows() * NUM_SUMS, 0),
+      direct(matrix.getNumRows(), 0),
+      numSums(NUM_SUMS),
+      oldTop(nameRanks, k),
+      newTop(nameRanks, k),
+      limits(limits),
+      lastWork(0),
+      truncated(false) {}
+
+/**
+ * Returns how many of a collaborator's costars are read under the hub cap
+ * Params:
+ * - numCostars: the number of costars of the collaborator
+ * Returns: all of them below the cap, otherwise none or the cap by the
+ *          policy
+ */
+int LinkPredictor::capTake(int numCostars) {
+    if (!limits.hubCap || numCostars <= limits.hubCap) {
+        return numCostars;
+    }
+    return limits.policy == CAP_SAMPLE ? limits.hubCap : 0;
+}
+
+/**
+ * Returns the group a collaborator is expanded in when over budget
+ * Params:
+ * - middle: the id of the collaborator
+ * Returns: the power of two at or below its number of costars
+ */
+int LinkPredictor::getGroup(int middle) {
+    int numCostars = matrix.getRowLength(middle);
+    return numCostars > 0 ? 31 - __builtin_clz(numCostars) : 0;
+}
+
+/**
+ * Adds what a collaborator's costars get through them to their sums
+ * Params:
+ * - middle: the id of the collaborator
+ * - weight: the movies the actor made with the collaborator
+ * - take: how many of its costars to read, an even sample scaled up to
+ *   all of them if fewer than all
+ * Returns: void
+ */
+void LinkPredictor::expand(int middle, int weight, int take) {
+    const int* costars = matrix.getColumns(middle);
+    const int* counts = matrix.getValues(middle);
+    int numCostars = matrix.getRowLength(middle);
+    double scale = (double)numCostars / take;
+    if (numSums == 1) {
+        for (int sample = 0; sample < take; sample++) {
+            int costar = take == numCostars
+                             ? sample
+                             : (int)((long)sample * numCostars / take);
+            double& sum = sums[costars[costar]];
+            if (sum == 0) {
+                touched.push_back(costars[costar]);
+            }
+            sum += scale * weight * counts[costar];
+        }
+        return;
+    }
+    // What the middle actor adds to each of its costars' sums. The lanes are
+    // a fixed count, so adding them compiles to vector adds.
+    double added[NUM_SUMS];
+    added[COMMON_SUM] = scale;
+    added[ADAMIC_ADAR_SUM] = numCostars > 1 ? scale / log(numCostars) : 0;
+    added[RESOURCE_SUM] = scale / numCostars;
+    for (int sample = 0; sample < take; sample++) {
+        int costar = take == numCostars
+                         ? sample
+                         : (int)((long)sample * numCostars / take);
+        double* sum = &sums[(size_t)costars[costar] * NUM_SUMS];
+        if (sum[WEIGHTED_SUM] == 0) {
+            touched.push_back(costars[costar]);
+        }
+        added[WEIGHTED_SUM] = scale * weight * counts[costar];
+        for (int lane = 0; lane < NUM_SUMS; lane++) {
+            sum[lane] += added[lane];
+        }
+    }
+}
+
+/**
+ * Returns the score of a candidate under a model from its sums
+ * Params:
+ * - model: the number of the model
+ * - actor: the id of the actor being predicted
+ * - candidate: the id of the candidate
+ * Returns: the score of the candidate
+ */
+double LinkPredictor::score(int model, int actor, int candidate) {
+    const double* sum = &sums[(size_t)candidate * numSums];
+    double degrees = matrix.getRowLength(actor);
+    double candidateDegrees = matrix.getRowLength(candidate);
+    switch (model) {
+        case COMMON_MODEL:
+            return sum[COMMON_SUM];
+        case JACCARD_MODEL:
+            return sum[COMMON_SUM] /
+                   (degrees + candidateDegrees - sum[COMMON_SUM]);
+        case ADAMIC_ADAR_MODEL:
+            return sum[ADAMIC_ADAR_SUM];
+        case RESOURCE_MODEL:
+            return sum[RESOURCE_SUM];
+        case PREFERENTIAL_MODEL:
+            return degrees * candidateDegrees;
+        case KATZ_MODEL:
+            return KATZ_BETA * direct[candidate] +
+                   KATZ_BETA * KATZ_BETA * sum[WEIGHTED_SUM];
+        default:
+            return sum[WEIGHTED_SUM];
+    }
+}
+
+/**
+ * Predicts the actors most likely to be in the next movie of an actor.
+ * An actor's score is the sum, over the collaborators they share with
+ * the actor, of the movies the actor made with that collaborator times
+ * the movies the collaborator made with them.
+ * Params:
+ * - actor: the id of the actor
+ * - collabs: filled with the top actors who already collaborated
+ * - uncollabs: filled with the top actors two steps away who have not
+ * Returns: void
+ */
+void LinkPredictor::predict(int actor, vector<string>& collabs,
+                            vector<string>& uncollabs) {
+    vector<vector<string>> allCollabs;
+    vector<vector<string>> allUncollabs;
+    predict(actor, {WEIGHTED_MODEL}, allCollabs, allUncollabs);
+    collabs = allCollabs[0];
+    uncollabs = allUncollabs[0];
+}
+
+/**
+ * Predicts the actors most likely to be in the next movie of an actor
+ * under several models, expanding the actor's neighborhood only once
+ * Params:
+ * - actor: the id of the actor
+ * - models: the numbers of the models
+ * - collabs: filled with the top collaborators under each model
+ * - uncollabs: filled with the top actors two steps away under each model
+ * Returns: void
+ */
+void LinkPredictor::predict(int actor, const vector<int>& models,
+                            vector<vector<string>>& collabs,
+                            vector<vector<string>>& uncollabs) {
+    vector<vector<int>> collabIds;
+    vector<vector<int>> uncollabIds;
+    predictIds(actor, models, collabIds, uncollabIds);
+    collabs.assign(models.size(), {});
+    uncollabs.assign(models.size(), {});
+    for (int model = 0; model < (int)models.size(); model++) {
+        collabs[model] = getNames(graph, collabIds[model]);
+        uncollabs[model] = getNames(graph, uncollabIds[model]);
+    }
+}
+
+/**
+ * Predicts the ids of the actors most likely to be in the next movie of an
+ * actor under several models, expanding the actor's neighborhood only once
+ * Params:
+ * - actor: the id of the actor
+ * - models: the numbers of the models
+ * - collabs: filled with the ids of the top collaborators under each model
+ * - uncollabs: filled with the ids of the top actors two steps away under
+ *   each model
+ * Returns: void
+ */
+void LinkPredictor::predictIds(int actor, const vector<int>& models,
+                               vector<vector<int>>& collabs,
+                               vector<vector<int>>& uncollabs) {
+    const int* columns = matrix.getColumns(actor);
+    const int* values = matrix.getValues(actor);
+    int length = matrix.getRowLength(actor);
+    lastWork = length;
+
+    // Models read from the weighted sum alone only keep that one
+    numSums = 1;
+    for (int model : models) {
+        if (model != WEIGHTED_MODEL && model != PREFERENTIAL_MODEL &&
+            model != KATZ_MODEL) {
+            numSums = NUM_SUMS;
+        }
+    }
+
+    for (int entry = 0; entry < length; entry++) {
+        direct[columns[entry]] = values[entry];
+    }
+    truncated = false;
+    if (!limits.hubCap && !limits.budget) {
+        // Expands every collaborator's row into the sums
+        for (int entry = 0; entry < length; entry++) {
+            int numCostars = matrix.getRowLength(columns[entry]);
+            lastWork += numCostars;
+            expand(columns[entry], values[entry], numCostars);
+        }
+    } else {
+        // Costars read through each collaborator under the cap
+        long total = lastWork;
+        for (int entry = 0; entry < length; entry++) {
+            total += capTake(matrix.getRowLength(columns[entry]));
+        }
+        // Over budget, collaborators are expanded from the fewest costars up,
+        // grouped by the power of two below their costars. Each group keeps
+        // the order of ids, so rows are still read mostly in order.
+        order.clear();
+        if (limits.budget && total > limits.budget) {
+            int groupStarts[GROUPS + 1] = {0};
+            for (int entry = 0; entry < length; entry++) {
+                groupStarts[getGroup(columns[entry]) + 1]++;
+            }
+            for (int group = 0; group < GROUPS; group++) {
+                groupStarts[group + 1] += groupStarts[group];
+            }
+            order.resize(length);
+            for (int entry = 0; entry < length; entry++) {
+                order[groupStarts[getGroup(columns[entry])]++] = entry;
+            }
+        }
+        for (int next = 0; next < length; next++) {
+            int entry = order.empty() ? next : order[next];
+            int numCostars = matrix.getRowLength(columns[entry]);
+            int take = capTake(numCostars);
+            if (limits.budget && lastWork + take > limits.budget) {
+                take = limits.policy == CAP_SAMPLE
+                           ? (int)max(0L, limits.budget - lastWork)
+                           : 0;
+            }
+            if (take < numCostars) {
+                truncated = true;
+            }
+            if (take > 0) {
+                lastWork += take;
+                expand(columns[entry], values[entry], take);
+            }
+        }
+    }
+
+    // Reads every model's lists from the same sums
+    collabs.assign(models.size(), {});
+    uncollabs.assign(models.size(), {});
+    for (int model = 0; model < (int)models.size(); model++) {
+        for (int entry = 0; entry < length; entry++) {
+            oldTop.offer(score(models[model], actor, columns[entry]),
+                         columns[entry]);
+        }
+        for (int id : touched) {
+            if (direct[id] == 0 && id != actor) {
+                newTop.offer(score(models[model], actor, id), id);
+            }
+        }
+        collabs[model] = oldTop.takeTop();
+        uncollabs[model] = newTop.takeTop();
+    }
+    for (int id : touched) {
+        fill_n(&sums[(size_t)id * numSums], numSums, 0.0);
+    }
+    for (int entry = 0; entry < length; entry++) {
+        direct[columns[entry]] = 0;
+    }
+    touched.clear();
+}
+
+/**
+ * Returns the number of matrix entries read by the last prediction
+ * Params: None
+ * Returns: the number of entries
+ */
+long LinkPredictor::getLastWork() { return lastWork; }
+
+/**
+ * Returns whether the last prediction skipped or sampled any of the
+ * neighborhood because of the work limits
+ * Params: None
+ * Returns: true if its lists may differ from the exact ones
+ */
+bool LinkPredictor::wasTruncated() { return truncated; }
+
+/**
+ * Predicts the ids of both lists of many actors under one model, with a
+ * LinkPredictor per thread and each thread taking the next actor
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - ids: the ids of the actors
+ * - model: the number of the scoring model
+ * - numThreads: the number of threads to use
+ * - collabs: filled with the ids of the top collaborators of each actor, in
+ *   the order of ids
+ * - uncollabs: filled with the ids of the top new actors of each actor
+ * Returns: void
+ */
+void predictIdsParallel(ActorGraph& graph, CollabMatrix& matrix,
+                        const vector<int>& nameRanks, int k,
+                        const vector<int>& ids, int model, int numThreads,
+                        vector<vector<int>>& collabs,
+                        vector<vector<int>>& uncollabs) {
+    collabs.assign(ids.size(), {});
+    uncollabs.assign(ids.size(), {});
+    atomic<int> next(0);
+    runWorkers(numThreads, [&](int) {
+        LinkPredictor predictor(graph, matrix, nameRanks, k);
+        vector<vector<int>> modelCollabs;
+        vector<vector<int>> modelUncollabs;
+        for (int query = next++; query < (int)ids.size(); query = next++) {
+            predictor.predictIds(ids[query], {model}, modelCollabs,
+                                 modelUncollabs);
+            collabs[query] = move(modelCollabs[0]);
+            uncollabs[query] = move(modelUncollabs[0]);
+        }
+    });
+}
+
+/**
+ * Constructs a predictor for a graph
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph
+ * - index: the MinHash index of the matrix
+ * - nameRanks: the alphabetical rank of each actor's name
+ * - k: the number of actors to predict in each list
+ */
+ApproximatePredictor::ApproximatePredictor(ActorGraph& graph,
+                                           CollabMatrix& matrix,
+                                           MinHashIndex& index,
+                                           const vector<int>& nameRanks, int k)
+    : graph(graph),
+      matrix(matrix),
+      index(index),
+      direct(matrix.getNumRows(), 0),
+      partial(matrix.getNumRows(), 0),
+      isCandidate(matrix.getNumRows(), false),
+      oldTop(nameRanks, k),
+      newTop(nameRanks, k),
+      shortlist(nameRanks, k * SHORTLIST_FACTOR) {}
+
+/**
+ * Scores candidates exactly and offers them to a selector
+ * Params:
+ * - ids: the candidates
+ * - top: the selector offered the exact scores
+ * - positive: whether only candidates with a positive score are offered
+ * Returns: void
+ */
+void ApproximatePredictor::rescore(const vector<int>& ids, TopKSelector& top,
+                                   bool positive) {
+    // The actor's row is spread out in direct, so each candidate's row only
+    // needs to be read once
+    for (int id : ids) {
+        const int* columns = matrix.getColumns(id);
+        const int* values = matrix.getValues(id);
+        int length = matrix.getRowLength(id);
+        int score = 0;
+        for (int entry = 0; entry < length; entry++) {
+            score += values[entry] * direct[columns[entry]];
+        }
+        if (!positive || score > 0) {
+            top.offer(score, id);
+        }
+    }
+}
+
+/**
+ * Predicts the actors most likely to be in the next movie of an actor,
+ * scored like LinkPredictor
+ * Params:
+ * - actor: the id of the actor
+ * - collabs: filled with the top shortlisted actors who already
+ *   collaborated
+ * - uncollabs: filled with the top shortlisted actors reached by the sample
+ *   or found by the index who have not collaborated yet
+ * Returns: void
+ */
+void ApproximatePredictor::predict(int actor, vector<string>& collabs,
+                                   vector<string>& uncollabs) {
+    const int* columns = matrix.getColumns(actor);
+    const int* values = matrix.getValues(actor);
+    int length = matrix.getRowLength(actor);
+    for (int entry = 0; entry < length; entry++) {
+        direct[columns[entry]] = values[entry];
+    }
+
+    // Expands through the collaborators the actor made the most movies with,
+    // cheapest first among equals, until the budget is read. They add the
+    // most to any score, so the sampled scores rank like the exact ones.
+    sampled.assign(columns, columns + length);
+    sort(sampled.begin(), sampled.end(), [&](int lhs, int rhs) {
+        if (direct[lhs] != direct[rhs]) {
+            return direct[lhs] > direct[rhs];
+        }
+        return matrix.getRowLength(lhs) < matrix.getRowLength(rhs);
+    });
+    long budget = (long)SAMPLE_FACTOR * length;
+    int numExpanded = 0;
+    for (; numExpanded < length && budget > 0; numExpanded++) {
+        int collaborator = sampled[numExpanded];
+        const int* costars = matrix.getColumns(collaborator);
+        const int* movies = matrix.getValues(collaborator);
+        int numCostars = matrix.getRowLength(collaborator);
+        for (int entry = 0; entry < numCostars; entry++) {
+            int id = costars[entry];
+            if (id != actor && !isCandidate[id]) {
+                isCandidate[id] = true;
+                candidates.push_back(id);
+            }
+            partial[id] += direct[collaborator] * movies[entry];
+        }
+        budget -= numCostars;
+    }
+
+    // The expanded collaborators miss the most from their sampled scores,
+    // since their own rows add nothing to them, but rereading those rows
+    // costs no more than the sample did
+    for (int entry = numExpanded; entry < length; entry++) {
+        shortlist.offer(partial[sampled[entry]], sampled[entry]);
+    }
+    sampled.resize(numExpanded);
+    rescore(sampled, oldTop, false);
+    rescore(shortlist.takeTop(), oldTop, false);
+
+    // Actors the index finds alike but the sample missed are kept, ranked
+    // below every reached actor
+    int numReached = (int)candidates.size();
+    index.findCandidates(actor, candidates);
+    for (int candidate = 0; candidate < (int)candidates.size(); candidate++) {
+        int id = candidates[candidate];
+        if (direct[id] == 0 &&
+            (candidate < numReached || !isCandidate[id])) {
+            isCandidate[id] = true;
+            shortlist.offer(partial[id], id);
+        }
+    }
+    rescore(shortlist.takeTop(), newTop, true);
+
+    for (int id : candidates) {
+        isCandidate[id] = false;
+        partial[id] = 0;
+    }
+    partial[actor] = 0;
+    for (int entry = 0; entry < length; entry++) {
+        direct[columns[entry]] = 0;
+    }
+    candidates.clear();
+
+    collabs = getNames(graph, oldTop.takeTop());
+    uncollabs = getNames(graph, newTop.takeTop());
+}
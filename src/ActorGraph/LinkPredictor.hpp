@@ -0,0 +1,393 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Gilbert, Moler and Schreiber, "Sparse Matrices in MATLAB: Design
+ * and Implementation"; Liben-Nowell and Kleinberg, "The Link Prediction
+ * Problem for Social Networks"
+ * Description: This file contains the declaration of the LinkPredictor, which
+ * finds both lists of likely collaborators of an actor in one pass, under any
+ * of several scoring models.
+ */
+
+#ifndef LINKPREDICTOR_HPP
+#define LINKPREDICTOR_HPP
+
+#include <string>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "CollabMatrix.hpp"
+#include "MinHashIndex.hpp"
+#include "TopKSelector.hpp"
+
+using namespace std;
+
+// Default number of actors predicted in each list
+#define TOP_RANK 4
+
+// Ways of scoring a candidate, by what they share with the actor
+#define WEIGHTED_MODEL 0      // Movies with each shared collaborator, multiplied
+#define COMMON_MODEL 1        // Number of shared collaborators
+#define JACCARD_MODEL 2       // Shared collaborators over all of either's
+#define ADAMIC_ADAR_MODEL 3   // Shared collaborators, 1 / log of their degree
+#define RESOURCE_MODEL 4      // Shared collaborators, 1 / their degree
+#define PREFERENTIAL_MODEL 5  // Product of both numbers of collaborators
+#define KATZ_MODEL 6          // Paths of length one and two, damped
+#define NUM_MODELS 7
+
+// Name of each model, by its number
+const char* const MODEL_NAMES[NUM_MODELS] = {
+    "weighted", "cn", "jaccard", "adamic-adar", "ra", "pa", "katz"};
+
+// Damping of each step of a path in the Katz model
+#define KATZ_BETA 0.05
+
+// Candidates per predicted actor scored exactly by the ApproximatePredictor
+#define SHORTLIST_FACTOR 8
+
+// Matrix entries per collaborator the ApproximatePredictor reads expanding
+#define SAMPLE_FACTOR 8
+
+// Groups of collaborators by the power of two below their costars
+#define GROUPS 32
+
+// What to do with a collaborator with more costars than the cap
+#define CAP_SKIP 0    // Do not expand through them
+#define CAP_SAMPLE 1  // Expand through an even sample of them, scaled up
+
+/*
+ * Bounds on the work of one prediction, zero for no bound. Collaborators with
+ * more than hubCap costars are skipped or sampled by the policy, and once
+ * budget matrix entries have been read the remaining collaborators are too.
+ */
+struct WorkLimits {
+    int hubCap = 0;          // Costars from which a collaborator is capped
+    int policy = CAP_SKIP;   // CAP_SKIP or CAP_SAMPLE
+    long budget = 0;         // Matrix entries read by one prediction
+};
+
+// Sums kept per candidate by the shared expansion, every model is read from
+// these and the degrees
+#define WEIGHTED_SUM 0
+#define COMMON_SUM 1
+#define ADAMIC_ADAR_SUM 2
+#define RESOURCE_SUM 3
+#define NUM_SUMS 4
+
+/**
+ * Returns the number of a scoring model given its name
+ * Params:
+ * - name: the name of the model
+ * Returns: the number of the model, or -1 if there is no such model
+ */
+int findModel(const string& name);
+
+/**
+ * Returns the names of actors given their ids
+ * Params:
+ * - graph: the graph of all actors
+ * - ids: the ids of the actors
+ * Returns: the names, in the same order
+ */
+vector<string> getNames(ActorGraph& graph, const vector<int>& ids);
+
+/**
+ * Returns the score of a candidate by intersecting its row of the matrix with
+ * the actor's: the sum, over their shared collaborators, of the movies the
+ * actor made with that collaborator times the movies it made with the
+ * candidate
+ * Params:
+ * - matrix: the collaboration matrix
+ * - actor: the id of the actor
+ * - candidate: the id of the candidate
+ * - direct: the movies each id made with the actor
+ * - matches: room for the positions of the shared collaborators
+ * Returns: the score of the candidate
+ */
+int scoreByIntersection(CollabMatrix& matrix, int actor, int candidate,
+                        const vector<int>& direct, vector<int>& matches);
+
+/**
+ * Returns the score of a pair of actors under a model, scored like the
+ * LinkPredictor scores a candidate, from the intersection of their rows of
+ * the matrix alone, so the time grows with the sum of their numbers of
+ * collaborators rather than with the actor's two step neighborhood
+ * Params:
+ * - matrix: the collaboration matrix
+ * - model: the number of the model
+ * - actor: the id of one actor
+ * - other: the id of the other actor
+ * - matches: room for the positions of the shared collaborators in the
+ *   actor's row
+ * - otherMatches: room for their positions in the other actor's row
+ * Returns: the score of the pair
+ */
+double scorePair(CollabMatrix& matrix, int model, int actor, int other,
+                 vector<int>& matches, vector<int>& otherMatches);
+
+/**
+ * Predicts the top k actors that are most likely to be in the next movie
+ * with actor out of those who already collaborated with the actor
+ * Params:
+ * - graph: the graph of all actors
+ * - actorName: name of actor to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict
+ * Returns: top k actors in next movie (out of collaborators), or none if
+ *          the actor is not in the graph
+ */
+vector<string> predictCollaborate(ActorGraph& graph, string actorName,
+                                  int fromYear, int toYear,
+                                  const vector<int>& nameRanks, int k);
+
+/**
+ * Predicts the top k actors that are most likely to be in the next movie
+ * with actor out of those who haven't collaborated with the actor
+ * Params:
+ * - graph: the graph of all actors
+ * - actorName: name of actor to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict
+ * Returns: top k actors in next movie (out of non-collaborators), or none if
+ *          the actor is not in the graph
+ */
+vector<string> predictNew(ActorGraph& graph, string actorName, int fromYear,
+                          int toYear, const vector<int>& nameRanks, int k);
+
+/**
+ * This class predicts the collaborators of one actor at a time from a
+ * CollabMatrix. The two step neighborhood of the actor is expanded once into
+ * a sparse accumulator: a dense score per actor id that is reused between
+ * actors, and a list of the ids it touched so that only those are read and
+ * reset afterwards. Every candidate keeps NUM_SUMS sums side by side, which
+ * are all accumulated by one vector addition per entry, so every model is
+ * scored from the same expansion. When only models read from the weighted
+ * sum are asked for, just that sum is kept. When a WorkLimits budget would be
+ * exceeded, collaborators are expanded from the fewest costars up, so a
+ * truncated prediction has still read the collaborators that say the most
+ * about each candidate. Collaborators and new actors are then both
+ * read from the sums straight into bounded top k selectors. Each thread needs
+ * its own LinkPredictor.
+ */
+class LinkPredictor {
+  private:
+    ActorGraph& graph;           // The graph of all actors
+    CollabMatrix& matrix;        // Movies shared by each pair of actors
+    vector<double> sums;         // NUM_SUMS sums per actor id, zero if untouched
+    vector<int> direct;          // Movies each id made with the actor
+    int numSums;                 // Sums per id kept by the current prediction
+    vector<int> touched;         // Ids with nonzero sums
+    TopKSelector oldTop;         // Best collaborators
+    TopKSelector newTop;         // Best actors two steps away
+    WorkLimits limits;           // Bounds on the work of each prediction
+    vector<int> order;           // Entries in the order they are expanded
+    long lastWork;               // Entries read by the last prediction
+    bool truncated;              // Whether the last prediction hit a limit
+
+    /**
+     * Returns how many of a collaborator's costars are read under the hub cap
+     * Params:
+     * - numCostars: the number of costars of the collaborator
+     * Returns: all of them below the cap, otherwise none or the cap by the
+     *          policy
+     */
+    int capTake(int numCostars);
+
+    /**
+     * Returns the group a collaborator is expanded in when over budget
+     * Params:
+     * - middle: the id of the collaborator
+     * Returns: the power of two at or below its number of costars
+     */
+    int getGroup(int middle);
+
+    /**
+     * Adds what a collaborator's costars get through them to their sums
+     * Params:
+     * - middle: the id of the collaborator
+     * - weight: the movies the actor made with the collaborator
+     * - take: how many of its costars to read, an even sample scaled up to
+     *   all of them if fewer than all
+     * Returns: void
+     */
+    void expand(int middle, int weight, int take);
+
+    /**
+     * Returns the score of a candidate under a model from its sums
+     * Params:
+     * - model: the number of the model
+     * - actor: the id of the actor being predicted
+     * - candidate: the id of the candidate
+     * Returns: the score of the candidate
+     */
+    double score(int model, int actor, int candidate);
+
+  public:
+    /**
+     * Constructs a predictor for a graph
+     * Params:
+     * - graph: the graph of all actors
+     * - matrix: the collaboration matrix of the graph
+     * - nameRanks: the alphabetical rank of each actor's name
+     * - k: the number of actors to predict in each list
+     * - limits: bounds on the work of each prediction
+     */
+    LinkPredictor(ActorGraph& graph, CollabMatrix& matrix,
+                  const vector<int>& nameRanks, int k = TOP_RANK,
+                  WorkLimits limits = WorkLimits());
+
+    /**
+     * Predicts the actors most likely to be in the next movie of an actor.
+     * An actor's score is the sum, over the collaborators they share with
+     * the actor, of the movies the actor made with that collaborator times
+     * the movies the collaborator made with them.
+     * Params:
+     * - actor: the id of the actor
+     * - collabs: filled with the top actors who already collaborated
+     * - uncollabs: filled with the top actors two steps away who have not
+     * Returns: void
+     */
+    void predict(int actor, vector<string>& collabs,
+                 vector<string>& uncollabs);
+
+    /**
+     * Predicts the actors most likely to be in the next movie of an actor
+     * under several models, expanding the actor's neighborhood only once
+     * Params:
+     * - actor: the id of the actor
+     * - models: the numbers of the models
+     * - collabs: filled with the top collaborators under each model
+     * - uncollabs: filled with the top actors two steps away under each model
+     * Returns: void
+     */
+    void predict(int actor, const vector<int>& models,
+                 vector<vector<string>>& collabs,
+                 vector<vector<string>>& uncollabs);
+
+    /**
+     * Predicts the ids of the actors most likely to be in the next movie of
+     * an actor under several models, expanding the actor's neighborhood only
+     * once
+     * Params:
+     * - actor: the id of the actor
+     * - models: the numbers of the models
+     * - collabs: filled with the ids of the top collaborators under each model
+     * - uncollabs: filled with the ids of the top actors two steps away under
+     *   each model
+     * Returns: void
+     */
+    void predictIds(int actor, const vector<int>& models,
+                    vector<vector<int>>& collabs,
+                    vector<vector<int>>& uncollabs);
+
+    /**
+     * Returns the number of matrix entries read by the last prediction
+     * Params: None
+     * Returns: the number of entries
+     */
+    long getLastWork();
+
+    /**
+     * Returns whether the last prediction skipped or sampled any of the
+     * neighborhood because of the work limits
+     * Params: None
+     * Returns: true if its lists may differ from the exact ones
+     */
+    bool wasTruncated();
+};
+
+/**
+ * Predicts the ids of both lists of many actors under one model, with a
+ * LinkPredictor per thread and each thread taking the next actor
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - ids: the ids of the actors
+ * - model: the number of the scoring model
+ * - numThreads: the number of threads to use
+ * - collabs: filled with the ids of the top collaborators of each actor, in
+ *   the order of ids
+ * - uncollabs: filled with the ids of the top new actors of each actor
+ * Returns: void
+ */
+void predictIdsParallel(ActorGraph& graph, CollabMatrix& matrix,
+                        const vector<int>& nameRanks, int k,
+                        const vector<int>& ids, int model, int numThreads,
+                        vector<vector<int>>& collabs,
+                        vector<vector<int>>& uncollabs);
+
+/**
+ * This class predicts the collaborators of one actor at a time without
+ * expanding the actor's whole two step neighborhood, which is what makes
+ * actors with thousands of collaborators slow. Only the collaborators the
+ * actor made the most movies with are expanded, reading SAMPLE_FACTOR
+ * entries of the matrix per collaborator, which adds the largest terms of
+ * every score. Actors that a MinHashIndex finds to have alike collaborators
+ * are considered as new actors too. The expanded collaborators are scored
+ * exactly, everyone else is first ranked by this partial score, and only the
+ * best SHORTLIST_FACTOR * k of each list are scored exactly by reading their
+ * rows, so a likely actor may be missed, but the order of those kept is
+ * exact. Each thread needs its own
+ * ApproximatePredictor.
+ */
+class ApproximatePredictor {
+  private:
+    ActorGraph& graph;         // The graph of all actors
+    CollabMatrix& matrix;      // Movies shared by each pair of actors
+    MinHashIndex& index;       // Actors with alike collaborators
+    vector<int> direct;        // Movies each id made with the actor
+    vector<int> partial;       // Score of each id from the sample
+    vector<bool> isCandidate;  // Whether each id was already considered
+    vector<int> candidates;    // Ids reached or found by the index
+    vector<int> sampled;       // Collaborators in the order they are expanded
+    TopKSelector oldTop;       // Best collaborators
+    TopKSelector newTop;       // Best new actors
+    TopKSelector shortlist;    // Highest partial scores
+
+    /**
+     * Scores candidates exactly and offers them to a selector
+     * Params:
+     * - ids: the candidates
+     * - top: the selector offered the exact scores
+     * - positive: whether only candidates with a positive score are offered
+     * Returns: void
+     */
+    void rescore(const vector<int>& ids, TopKSelector& top, bool positive);
+
+  public:
+    /**
+     * Constructs a predictor for a graph
+     * Params:
+     * - graph: the graph of all actors
+     * - matrix: the collaboration matrix of the graph
+     * - index: the MinHash index of the matrix
+     * - nameRanks: the alphabetical rank of each actor's name
+     * - k: the number of actors to predict in each list
+     */
+    ApproximatePredictor(ActorGraph& graph, CollabMatrix& matrix,
+                         MinHashIndex& index, const vector<int>& nameRanks,
+                         int k = TOP_RANK);
+
+    /**
+     * Predicts the actors most likely to be in the next movie of an actor,
+     * scored like LinkPredictor
+     * Params:
+     * - actor: the id of the actor
+     * - collabs: filled with the top shortlisted actors who already
+     *   collaborated
+     * - uncollabs: filled with the top shortlisted actors reached by the
+     *   sample or found by the index who have not collaborated yet
+     * Returns: void
+     */
+    void predict(int actor, vector<string>& collabs,
+                 vector<string>& uncollabs);
+};
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Broder, "On the Resemblance and Containment of Documents";
+ * Leskovec, Rajaraman and Ullman, "Mining of Massive Datasets", chapter 3
+ * Description: This file contains the implementation for the MinHashIndex.
+ */
+
+#include <algorithm>
+
+#include "MinHashIndex.hpp"
+#include "Workers.hpp"
+
+/**
+ * Scrambles the bits of a number so that close numbers hash far apart
+ * Params:
+ * - bits: the number
+ * Returns: the hash
+ */
+static inline uint64_t mixBits(uint64_t bits) {
+    bits += 0x9e3779b97f4a7c15ULL;
+    bits = (bits ^ (bits >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    bits = (bits ^ (bits >> 27)) * 0x94d049bb133111ebULL;
+    return bits ^ (bits >> 31);
+}
+
+/**
+ * Builds the signatures and buckets of every actor with collaborators
+ * Params:
+ * - matrix: the collaboration matrix
+ * - bands: the number of bands
+ * - rows: the number of hashes in each band
+ * - numThreads: the number of threads to hash with
+ */
+MinHashIndex::MinHashIndex(CollabMatrix& matrix, int bands, int rows,
+                           int numThreads)
+    : bands(bands), rows(rows), buckets(bands) {
+    int numActors = matrix.getNumRows();
+    int numHashes = bands * rows;
+    signatures.assign((size_t)numActors * numHashes, UINT32_MAX);
+
+    // Each thread hashes its own part of the actors
+    auto sign = [&](int part) {
+        int first = (long)numActors * part / numThreads;
+        int last = (long)numActors * (part + 1) / numThreads;
+        for (int actor = first; actor < last; actor++) {
+            uint32_t* signature = &signatures[(size_t)actor * numHashes];
+            const int* columns = matrix.getColumns(actor);
+            int length = matrix.getRowLength(actor);
+            for (int entry = 0; entry < length; entry++) {
+                uint64_t id = (uint32_t)columns[entry];
+                for (int hash = 0; hash < numHashes; hash++) {
+                    uint32_t value =
+                        (uint32_t)mixBits(((uint64_t)hash << 32) | id);
+                    signature[hash] = min(signature[hash], value);
+                }
+            }
+        }
+    };
+    runWorkers(numThreads, sign);
+
+    // Actors without collaborators are alike to no one
+    for (int band = 0; band < bands; band++) {
+        for (int actor = 0; actor < numActors; actor++) {
+            if (matrix.getRowLength(actor) > 0) {
+                buckets[band].push_back({getKey(actor, band), actor});
+            }
+        }
+        sort(buckets[band].begin(), buckets[band].end());
+    }
+}
+
+/**
+ * Returns the key of an actor's signature in one band
+ * Params:
+ * - actor: the id of the actor
+ * - band: the band
+ * Returns: the hash of the band's hashes
+ */
+uint64_t MinHashIndex::getKey(int actor, int band) {
+    const uint32_t* signature =
+        &signatures[(size_t)actor * bands * rows + (size_t)band * rows];
+    uint64_t key = band;
+    for (int row = 0; row < rows; row++) {
+        key = mixBits(key ^ signature[row]);
+    }
+    return key;
+}
+
+/**
+ * Adds the actors that share a bucket with an actor in any band. An
+ * actor may be added once per band they share.
+ * Params:
+ * - actor: the id of the actor
+ * - candidates: the ids the alike actors are appended to
+ * Returns: void
+ */
+void MinHashIndex::findCandidates(int actor, vector<int>& candidates) {
+    for (int band = 0; band < bands; band++) {
+        uint64_t key = getKey(actor, band);
+        auto bucket = lower_bound(buckets[band].begin(), buckets[band].end(),
+                                  BandKey(key, 0));
+        for (; bucket != buckets[band].end() && bucket->first == key;
+             bucket++) {
+            if (bucket->second != actor) {
+                candidates.push_back(bucket->second);
+            }
+        }
+    }
+}
+
+/**
+ * Estimates how many collaborators two actors share from how many hashes
+ * of their signatures agree
+ * Params:
+ * - actor: the id of an actor
+ * - other: the id of another actor
+ * - degree: the number of collaborators of actor
+ * - otherDegree: the number of collaborators of other
+ * Returns: the estimated number of shared collaborators
+ */
+double MinHashIndex::estimateShared(int actor, int other, int degree,
+                                    int otherDegree) {
+    int numHashes = bands * rows;
+    const uint32_t* signature = &signatures[(size_t)actor * numHashes];
+    const uint32_t* otherSignature = &signatures[(size_t)other * numHashes];
+    int agree = 0;
+    for (int hash = 0; hash < numHashes; hash++) {
+        agree += signature[hash] == otherSignature[hash];
+    }
+    // Shared = J * union and union = degree + otherDegree - shared
+    double similarity = (double)agree / numHashes;
+    return similarity * (degree + otherDegree) / (1 + similarity);
+}
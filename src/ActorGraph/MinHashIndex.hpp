@@ -0,0 +1,91 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Broder, "On the Resemblance and Containment of Documents";
+ * Leskovec, Rajaraman and Ullman, "Mining of Massive Datasets", chapter 3
+ * Description: This file contains the declaration of the MinHashIndex, which
+ * finds actors whose sets of collaborators are alike without comparing every
+ * pair of actors.
+ */
+
+#ifndef MINHASHINDEX_HPP
+#define MINHASHINDEX_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "CollabMatrix.hpp"
+
+using namespace std;
+
+// Default number of bands, and of hashes in each band
+#define LSH_BANDS 8
+#define LSH_ROWS 4
+
+// A band's hash of an actor's signature and the actor's id
+typedef pair<uint64_t, int> BandKey;
+
+/**
+ * This class keeps a MinHash signature of every actor's collaborators: for
+ * each of bands * rows hash functions, the smallest hash of any collaborator.
+ * Two actors agree on one of the hashes with probability equal to the
+ * Jaccard similarity of their collaborators. The signature is cut into bands
+ * of rows hashes, and actors whose hashes agree on a whole band land in the
+ * same bucket of that band, so alike actors are found by looking up the
+ * actor's bucket in each band. More bands find less alike actors too, more
+ * rows per band make the buckets smaller. The share of agreeing hashes also
+ * estimates the similarity of any two actors without reading their
+ * collaborators.
+ */
+class MinHashIndex {
+  private:
+    int bands;                        // Number of bands
+    int rows;                         // Hashes in each band
+    vector<uint32_t> signatures;      // bands * rows hashes per actor id
+    vector<vector<BandKey>> buckets;  // Per band, every key sorted
+
+    /**
+     * Returns the key of an actor's signature in one band
+     * Params:
+     * - actor: the id of the actor
+     * - band: the band
+     * Returns: the hash of the band's hashes
+     */
+    uint64_t getKey(int actor, int band);
+
+  public:
+    /**
+     * Builds the signatures and buckets of every actor with collaborators
+     * Params:
+     * - matrix: the collaboration matrix
+     * - bands: the number of bands
+     * - rows: the number of hashes in each band
+     * - numThreads: the number of threads to hash with
+     */
+    MinHashIndex(CollabMatrix& matrix, int bands, int rows, int numThreads);
+
+    /**
+     * Adds the actors that share a bucket with an actor in any band. An
+     * actor may be added once per band they share.
+     * Params:
+     * - actor: the id of the actor
+     * - candidates: the ids the alike actors are appended to
+     * Returns: void
+     */
+    void findCandidates(int actor, vector<int>& candidates);
+
+    /**
+     * Estimates how many collaborators two actors share from how many hashes
+     * of their signatures agree
+     * Params:
+     * - actor: the id of an actor
+     * - other: the id of another actor
+     * - degree: the number of collaborators of actor
+     * - otherDegree: the number of collaborators of other
+     * Returns: the estimated number of shared collaborators
+     */
+    double estimateShared(int actor, int other, int degree, int otherDegree);
+};
+
+#endif
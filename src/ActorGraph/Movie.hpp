@@ -3,6 +3,10 @@
 
 #include <string>
 
+// Bounds of year ranges that include every movie
+#define MIN_YEAR 0
+#define MAX_YEAR 9999
+
 using namespace std;
 
 /**
@@ -12,6 +16,7 @@ typedef struct Movie {
     string title;  // Title includes year
     string name;   // Name of movie
     int year;      // Year of movie
+    int id;        // Index of movie in its graph
 
     bool operator==(const Movie& other) { return title == other.title; }
     bool operator!=(const Movie& other) { return title != other.title; }
@@ -8,6 +8,7 @@
  * movies.
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -21,17 +22,39 @@
 
 // using namespace std;
 
+/**
+ * Compares an Edge to a year when binary searching the edges sorted by year
+ * Params:
+ * - edge: the Edge being compared
+ * - year: the year being searched for
+ * Returns: true if the edge's movie came out before year
+ */
+static bool edgeBeforeYear(Edge* edge, int year) {
+    return edge->getYear() < year;
+}
+
+/**
+ * Compares a year to an Edge when binary searching the edges sorted by year
+ * Params:
+ * - year: the year being searched for
+ * - edge: the Edge being compared
+ * Returns: true if the edge's movie came out after year
+ */
+static bool yearBeforeEdge(int year, Edge* edge) {
+    return year < edge->getYear();
+}
+
 /**
  * Constructs a new Node with the name of the actor
  * Params:
  *  - actor_name: the name of the actor
+ *  - actorId: the index of the actor in its graph
  */
-Node::Node(string actor_name) {
+Node::Node(string actor_name, int actorId) {
     name = actor_name;
+    id = actorId;
     prev = nullptr;
     pathWeight = MAX_WEIGHT;
-    sentinel = nullptr;
-    base = nullptr;
 }
 
 /**
@@ -43,8 +66,7 @@ Node::Node(string actor_name) {
  * Returns: void
  */
 void Node::addEdge(Node* other, Movie movie) {
-    Edge* edge = new Edge(this, other, movie);
-    edges.push_back(edge);
+    addEdge(new Edge(this, other, movie));
 }
 
 /**
@@ -68,8 +90,6 @@ int Node::getPathWeight() { return pathWeight; }
 void Node::uncheck() {
     done = false;
     prev = nullptr;
-    base = nullptr;
-    sentinel = nullptr;
     pathWeight = MAX_WEIGHT;
 }
 
@@ -84,22 +104,20 @@ bool Node::isDone() { return done; }
  * pointer to an edge
  * Params:
  * - newEdge: the new connecting edge between this actor node and another
+ * - indexYear: whether to also insert the edge into the year index; if
+ *              false, indexByYear must be called before the next range of
+ *              years is looked up
  * Returns: void
  */
-void Node::addEdge(Edge* newEdge) { edges.push_back(newEdge); }
-
-/**
- *  Sets the sentinel Node to sent
- *  Params:
- *  - sent: the sentinel node
- */
-void Node::setSentinel(Node* sent) { sentinel = sent; }
-
-/**
- * Gets the sentinel Node
- * Returns: The sentinel node of this Node
- */
-Node* Node::getSentinel() { return sentinel; }
+void Node::addEdge(Edge* newEdge, bool indexYear) {
+    edges.push_back(newEdge);
+    if (indexYear) {
+        // After any edges of the same year, as a stable sort would place it
+        edgesByYear.insert(upper_bound(edgesByYear.begin(), edgesByYear.end(),
+                                       newEdge->getYear(), yearBeforeEdge),
+                           newEdge);
+    }
+}
 
 /**
  * Sets the path from some other node to this node
@@ -139,19 +157,6 @@ void Node::setStart() {
     pathWeight = 0;
 }
 
-/**
- * Sets the base of the uptree to theBase
- * Params:
- * - theBase: the base of the uptree of the Node
- */
-void Node::setBase(Node* theBase) { base = theBase; }
-
-/**
- * Retuns the base of the uptree
- * Returns: the base of the uptree
- */
-Node* Node::getBase() { return base; }
-
 /**
  * Returns the path from some actor to this actor
  * Params: None
@@ -167,12 +172,58 @@ Edge* Node::getPrev() { return prev; }
  */
 vector<Edge*> Node::getEdges() { return edges; }
 
+/**
+ * Sorts a copy of the edges by the year of their movie so that a range of
+ * years can be found by binary search. Called after edges are added
+ * without indexing them, such as when a file is read.
+ * Params: None
+ * Returns: void
+ */
+void Node::indexByYear() {
+    edgesByYear = edges;
+    stable_sort(edgesByYear.begin(), edgesByYear.end(),
+                [](Edge* left, Edge* right) {
+                    return left->getYear() < right->getYear();
+                });
+}
+
+/**
+ * Returns the edges whose movies came out between fromYear and toYear
+ * (inclusive). If the range covers every edge, the edges are given in the
+ * order they were added so unrestricted searches are not affected.
+ * Params:
+ * - fromYear: the earliest year of a movie to include
+ * - toYear: the latest year of a movie to include
+ * Returns: a pair of iterators bounding the edges in the range
+ */
+pair<EdgeIter, EdgeIter> Node::getEdgesInYears(int fromYear,
+                                                int toYear) const {
+    if (edgesByYear.empty() || (edgesByYear.front()->getYear() >= fromYear &&
+                                edgesByYear.back()->getYear() <= toYear)) {
+        // Every edge is in range
+        return {edges.cbegin(), edges.cend()};
+    }
+    EdgeIter first = lower_bound(edgesByYear.cbegin(), edgesByYear.cend(),
+                                 fromYear, edgeBeforeYear);
+    EdgeIter last =
+        upper_bound(first, edgesByYear.cend(), toYear, yearBeforeEdge);
+    return {first, last};
+}
+
 /**
  * Returns the name of the actor contained by this node
  * Params: none
  * Returns: name of actor
  */
-string Node::getName() { return name; }
+const string& Node::getName() { return name; }
+
+/**
+ * Returns the index of the actor in its graph, from 0 to the number of
+ * actors - 1
+ * Params: none
+ * Returns: id of actor
+ */
+int Node::getId() { return id; }
 
 /**
  * Returns the edge pair connecting the node of this actor and the other
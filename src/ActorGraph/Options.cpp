@@ -0,0 +1,33 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation of parseOptions, which
+ * parses a tool's command line and prints the usage when it is malformed.
+ */
+
+#include <iostream>
+
+#include "Options.hpp"
+
+/**
+ * Parses the command line with the given options. An unknown option or a
+ * value that fails to parse prints the error and the usage to standard error
+ * instead of aborting.
+ * Params:
+ * - options: the options of the tool
+ * - argc: the number of arguments, left with the positional ones
+ * - argv: the arguments, left with the positional ones
+ * Returns: the parsed options, or nullptr if the command line is malformed
+ */
+unique_ptr<cxxopts::ParseResult> parseOptions(cxxopts::Options& options,
+                                              int& argc, char**& argv) {
+    try {
+        return unique_ptr<cxxopts::ParseResult>(
+            new cxxopts::ParseResult(options.parse(argc, argv)));
+    } catch (const cxxopts::OptionException& e) {
+        cerr << e.what() << endl << options.help() << endl;
+        return nullptr;
+    }
+}
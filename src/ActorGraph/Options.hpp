@@ -0,0 +1,32 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of parseOptions, which
+ * parses a tool's command line and prints the usage when it is malformed.
+ */
+
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include <memory>
+
+#include "cxxopts.hpp"
+
+using namespace std;
+
+/**
+ * Parses the command line with the given options. An unknown option or a
+ * value that fails to parse prints the error and the usage to standard error
+ * instead of aborting.
+ * Params:
+ * - options: the options of the tool
+ * - argc: the number of arguments, left with the positional ones
+ * - argv: the arguments, left with the positional ones
+ * Returns: the parsed options, or nullptr if the command line is malformed
+ */
+unique_ptr<cxxopts::ParseResult> parseOptions(cxxopts::Options& options,
+                                              int& argc, char**& argv);
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the PathTreeCache,
+ * which answers path queries by walking cached shortest path trees.
+ */
+
+#include <algorithm>
+#include <queue>
+
+#include "PathTreeCache.hpp"
+
+/**
+ * Constructs an empty cache
+ * Params:
+ * - theGraph: the graph the trees are built over
+ * - maxTrees: the maximum number of trees kept
+ * - firstYear: the earliest year of a movie the trees may use
+ * - lastYear: the latest year of a movie the trees may use
+ */
+PathTreeCache::PathTreeCache(ActorGraph& theGraph, int maxTrees, int firstYear,
+                             int lastYear) {
+    graph = &theGraph;
+    capacity = maxTrees;
+    fromYear = firstYear;
+    toYear = lastYear;
+    hits = 0;
+    misses = 0;
+}
+
+/**
+ * Returns the key of a tree
+ * Params:
+ * - root: the id of the tree's root
+ * - weighted: if the tree uses edge weights
+ * Returns: the key of the tree in index
+ */
+int PathTreeCache::getKey(int root, bool weighted) {
+    return root * 2 + (weighted ? 1 : 0);
+}
+
+/**
+ * Returns a cached tree and marks it as most recently used
+ * Params:
+ * - root: the id of the tree's root
+ * - weighted: if the tree uses edge weights
+ * Returns: the tree, or nullptr if it is not cached
+ */
+ShortestPathTree* PathTreeCache::lookup(int root, bool weighted) {
+    auto found = index.find(getKey(root, weighted));
+    if (found == index.end()) {
+        return nullptr;
+    }
+    // Moves the tree to the front of the list
+    trees.splice(trees.begin(), trees, found->second);
+    return *found->second;
+}
+
+/**
+ * Builds the complete shortest path tree of an actor with Dijkstra's
+ * algorithm (or BFS if unweighted). Doesn't modify the graph's Nodes.
+ * Params:
+ * - root: the id of the actor the tree starts from
+ * - weighted: if the tree uses edge weights
+ * Returns: a new tree that the caller owns
+ */
+ShortestPathTree* PathTreeCache::buildTree(int root, bool weighted) {
+    ShortestPathTree* tree = new ShortestPathTree;
+    tree->root = root;
+    tree->weighted = weighted;
+    tree->prev.assign(graph->getNumActors(), nullptr);
+    tree->distance.assign(graph->getNumActors(), MAX_WEIGHT);
+    tree->distance[root] = 0;
+
+    // Min heap of actors by distance; with unit weights it pops in BFS order
+    priority_queue<pair<int, int>, vector<pair<int, int>>,
+                   greater<pair<int, int>>>
+        frontier;
+    frontier.push({0, root});
+    while (!frontier.empty()) {
+        int distance = frontier.top().first;
+        int current = frontier.top().second;
+        frontier.pop();
+        if (distance > tree->distance[current]) {
+            // current was already settled
+            continue;
+        }
+        pair<EdgeIter, EdgeIter> neighbors =
+            graph->getActorById(current)->getEdgesInYears(fromYear, toYear);
+        for (EdgeIter edge = neighbors.first; edge != neighbors.second;
+             edge++) {
+            int neighbor = (*edge)->getDest()->getId();
+            int weight = weighted ? (*edge)->getWeight() : 1;
+            if (distance + weight < tree->distance[neighbor]) {
+                // Found a shorter path to neighbor
+                tree->distance[neighbor] = distance + weight;
+                tree->prev[neighbor] = *edge;
+                frontier.push({distance + weight, neighbor});
+            }
+        }
+    }
+    return tree;
+}
+
+/**
+ * Finds the path between two actors from a cached tree of either actor,
+ * optionally building and caching the tree of start on a miss
+ * Params:
+ * - start: the id of the actor the path starts from
+ * - end: the id of the actor the path ends at
+ * - weighted: if the path uses edge weights
+ * - build: if start's tree should be built when neither tree is cached
+ * - path: filled with the edges of the path from start to end
+ * - reversed: set to true if each edge of path goes from end's side to
+ *             start's side, so must be printed from destination to source
+ * Returns: true if the query was answered from a tree
+ */
+bool PathTreeCache::findPath(int start, int end, bool weighted, bool build,
+                             vector<Edge*>& path, bool& reversed) {
+    path.clear();
+    reversed = false;
+    ShortestPathTree* tree = lookup(start, weighted);
+    if (!tree) {
+        // The graph is undirected, so end's tree has the same path backwards
+        tree = lookup(end, weighted);
+        reversed = tree != nullptr;
+    }
+    if (!tree) {
+        if (!build || capacity <= 0) {
+            return false;
+        }
+        misses++;
+        tree = buildTree(start, weighted);
+        trees.push_front(tree);
+        index[getKey(start, weighted)] = trees.begin();
+        if ((int)trees.size() > capacity) {
+            // Evicts the least recently used tree
+            ShortestPathTree* oldest = trees.back();
+            index.erase(getKey(oldest->root, oldest->weighted));
+            trees.pop_back();
+            delete oldest;
+        }
+    } else {
+        hits++;
+    }
+
+    // Walks up the tree from the actor that isn't the root
+    int current = reversed ? start : end;
+    if (tree->distance[current] == MAX_WEIGHT || start == end) {
+        // Not reachable
+        return true;
+    }
+    while (current != tree->root) {
+        path.push_back(tree->prev[current]);
+        current = tree->prev[current]->getSource()->getId();
+    }
+    if (!reversed) {
+        // Edges were collected from end back to start
+        reverse(path.begin(), path.end());
+    }
+    return true;
+}
+
+/**
+ * Returns the fraction of answered queries that hit a cached tree
+ * Returns: the hit rate between 0 and 1
+ */
+double PathTreeCache::getHitRate() {
+    if (hits + misses == 0) {
+        return 0;
+    }
+    return (double)hits / (hits + misses);
+}
+
+/**
+ * Returns the number of queries that hit a cached tree
+ * Returns: the number of hits
+ */
+long PathTreeCache::getHits() { return hits; }
+
+/**
+ * Returns the number of trees that were built
+ * Returns: the number of misses
+ */
+long PathTreeCache::getMisses() { return misses; }
+
+/**
+ * Returns the memory used by the cached trees
+ * Returns: the size of the trees in bytes
+ */
+long PathTreeCache::getMemoryBytes() {
+    long bytes = 0;
+    for (auto iter = trees.begin(); iter != trees.end(); iter++) {
+        bytes += sizeof(ShortestPathTree) +
+                 (*iter)->prev.capacity() * sizeof(Edge*) +
+                 (*iter)->distance.capacity() * sizeof(int);
+    }
+    return bytes;
+}
+
+/**
+ * Destructor for the cache, frees all trees
+ * Params: None
+ */
+PathTreeCache::~PathTreeCache() {
+    for (auto iter = trees.begin(); iter != trees.end(); iter++) {
+        delete *iter;
+    }
+}
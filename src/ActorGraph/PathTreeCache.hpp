@@ -0,0 +1,142 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the PathTreeCache, which
+ * keeps the complete shortest path trees of the most recently used actors so
+ * that repeated queries on the same actors don't have to search again.
+ */
+
+#ifndef PATHTREECACHE_HPP
+#define PATHTREECACHE_HPP
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+struct ShortestPathTree;
+
+// Position of a tree in the cache's recency list
+typedef list<ShortestPathTree*>::iterator TreeIter;
+
+/**
+ * This struct holds every shortest path from one actor, as the edge from each
+ * actor's parent in the tree and each actor's distance from the root, indexed
+ * by actor id
+ */
+struct ShortestPathTree {
+    int root;              // Id of the actor the tree starts from
+    bool weighted;         // True if distances are edge weights, not hops
+    vector<Edge*> prev;    // Edge from parent, nullptr for root or unreached
+    vector<int> distance;  // Distance from root, MAX_WEIGHT if unreached
+};
+
+/**
+ * This class is a least recently used cache of shortest path trees keyed by
+ * the root actor and whether edges are weighted. Since the graph is
+ * undirected, a tree answers queries that start or end at its root.
+ */
+class PathTreeCache {
+  private:
+    ActorGraph* graph;                   // Graph the trees are built over
+    int capacity;                        // Maximum number of trees kept
+    int fromYear;                        // Earliest movie year trees use
+    int toYear;                          // Latest movie year trees use
+    list<ShortestPathTree*> trees;       // Trees, most recently used first
+    unordered_map<int, TreeIter> index;  // Position of each tree by key
+    long hits;                           // Queries answered from a cached tree
+    long misses;                         // Queries that had to build a tree
+
+    /**
+     * Returns the key of a tree
+     * Params:
+     * - root: the id of the tree's root
+     * - weighted: if the tree uses edge weights
+     * Returns: the key of the tree in index
+     */
+    int getKey(int root, bool weighted);
+
+    /**
+     * Returns a cached tree and marks it as most recently used
+     * Params:
+     * - root: the id of the tree's root
+     * - weighted: if the tree uses edge weights
+     * Returns: the tree, or nullptr if it is not cached
+     */
+    ShortestPathTree* lookup(int root, bool weighted);
+
+  public:
+    /**
+     * Constructs an empty cache
+     * Params:
+     * - theGraph: the graph the trees are built over
+     * - maxTrees: the maximum number of trees kept
+     * - firstYear: the earliest year of a movie the trees may use
+     * - lastYear: the latest year of a movie the trees may use
+     */
+    PathTreeCache(ActorGraph& theGraph, int maxTrees, int firstYear,
+                  int lastYear);
+
+    /**
+     * Builds the complete shortest path tree of an actor with Dijkstra's
+     * algorithm (or BFS if unweighted). Doesn't modify the graph's Nodes.
+     * Params:
+     * - root: the id of the actor the tree starts from
+     * - weighted: if the tree uses edge weights
+     * Returns: a new tree that the caller owns
+     */
+    ShortestPathTree* buildTree(int root, bool weighted);
+
+    /**
+     * Finds the path between two actors from a cached tree of either actor,
+     * optionally building and caching the tree of start on a miss
+     * Params:
+     * - start: the id of the actor the path starts from
+     * - end: the id of the actor the path ends at
+     * - weighted: if the path uses edge weights
+     * - build: if start's tree should be built when neither tree is cached
+     * - path: filled with the edges of the path from start to end
+     * - reversed: set to true if each edge of path goes from end's side to
+     *             start's side, so must be printed from destination to source
+     * Returns: true if the query was answered from a tree
+     */
+    bool findPath(int start, int end, bool weighted, bool build,
+                  vector<Edge*>& path, bool& reversed);
+
+    /**
+     * Returns the fraction of answered queries that hit a cached tree
+     * Returns: the hit rate between 0 and 1
+     */
+    double getHitRate();
+
+    /**
+     * Returns the number of queries that hit a cached tree
+     * Returns: the number of hits
+     */
+    long getHits();
+
+    /**
+     * Returns the number of trees that were built
+     * Returns: the number of misses
+     */
+    long getMisses();
+
+    /**
+     * Returns the memory used by the cached trees
+     * Returns: the size of the trees in bytes
+     */
+    long getMemoryBytes();
+
+    /**
+     * Destructor for the cache, frees all trees
+     * Params: None
+     */
+    ~PathTreeCache();
+};
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for Prim's algorithm
+ * with a bucket queue.
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include "Prim.hpp"
+
+/**
+ * This class holds actor ids in one bucket per weight. The cursor is the
+ * lightest bucket that may hold an actor.
+ */
+class BucketQueue {
+  private:
+    vector<vector<int>> buckets;  // Actor ids waiting at each weight
+    int minWeight;                // Weight of the first bucket
+    int cursor;                   // No bucket before this one holds an id
+    long numEntries;              // Ids in all buckets, stale ones included
+    long peakEntries;             // Most ids ever held at once
+
+  public:
+    /**
+     * Constructs an empty queue for weights from minWeight to maxWeight
+     * Params:
+     * - minWeight: the lowest weight
+     * - maxWeight: the highest weight
+     */
+    BucketQueue(int minWeight, int maxWeight)
+        : buckets(maxWeight - minWeight + 1),
+          minWeight(minWeight),
+          cursor(buckets.size()),
+          numEntries(0),
+          peakEntries(0) {}
+
+    /**
+     * Adds an actor at a weight, moving the cursor back if needed
+     * Params:
+     * - id: the id of the actor
+     * - weight: the weight of the edge that would add it to the tree
+     * Returns: void
+     */
+    void push(int id, int weight) {
+        int bucket = weight - minWeight;
+        buckets[bucket].push_back(id);
+        cursor = min(cursor, bucket);
+        peakEntries = max(peakEntries, ++numEntries);
+    }
+
+    /**
+     * Removes an actor from the lightest non-empty bucket
+     * Params:
+     * - id: set to the id of the actor
+     * - weight: set to the weight it was pushed with
+     * Returns: false if the queue is empty, otherwise true
+     */
+    bool pop(int& id, int& weight) {
+        while (cursor < (int)buckets.size() && buckets[cursor].empty()) {
+            cursor++;
+        }
+        if (cursor == (int)buckets.size()) {
+            return false;
+        }
+        id = buckets[cursor].back();
+        buckets[cursor].pop_back();
+        weight = cursor + minWeight;
+        numEntries--;
+        return true;
+    }
+
+    /**
+     * Returns the bytes of the buckets at their fullest
+     * Params: None
+     * Returns: the number of bytes
+     */
+    size_t getPeakBytes() {
+        return buckets.size() * sizeof(vector<int>) +
+               peakEntries * sizeof(int);
+    }
+};
+
+/**
+ * Finds a minimum spanning tree with Prim's algorithm. Edge weights are small
+ * integers, so the actors waiting to join the tree are kept in one bucket per
+ * weight instead of a heap, and each actor's edges are read exactly once,
+ * when it joins. Unlike Dijkstra, the weight of the next actor can be lower
+ * than the last one's, so the bucket cursor moves back when a lighter edge is
+ * found. Stale entries are skipped when popped.
+ * Params:
+ * - graph: the graph of all actors
+ * - start: the actor to grow the tree from, or nullptr to grow a tree from
+ *          every actor not yet reached, in id order, giving a forest
+ * - workBytes: if not nullptr, set to the peak bytes of the working arrays
+ * - sink: if set, receives each edge as it is chosen instead of the edges
+ *         being returned
+ * Returns: the edges of the minimum spanning tree or forest, or nothing if
+ *          sink is set
+ */
+vector<Edge*> findPrimForest(ActorGraph& graph, Node* start,
+                             size_t* workBytes, EdgeSink sink) {
+    int numActors = graph.getNumActors();
+    // Every edge is weighted by the year of its movie, so the movies bound
+    // the weights without reading any edge
+    int minWeight = INT_MAX;
+    int maxWeight = INT_MIN;
+    for (int movie = 0; movie < graph.getNumMovies(); movie++) {
+        int weight = Edge::weightOfYear(graph.getMovieById(movie).year);
+        minWeight = min(minWeight, weight);
+        maxWeight = max(maxWeight, weight);
+    }
+    vector<Edge*> forest;
+    if (minWeight > maxWeight) {
+        // No movies at all
+        return forest;
+    }
+
+    BucketQueue queue(minWeight, maxWeight);
+    vector<int> keys(numActors, INT_MAX);  // Lightest edge into the tree
+    vector<Edge*> via(numActors, nullptr);  // The edge with that weight
+    vector<bool> inTree(numActors, false);
+
+    int root = start ? start->getId() : 0;
+    for (; root < numActors; root++) {
+        if (inTree[root]) {
+            continue;
+        }
+        queue.push(root, minWeight);
+        int id;
+        int weight;
+        while (queue.pop(id, weight)) {
+            if (inTree[id] || (via[id] && weight != keys[id])) {
+                // Reached through a lighter edge since it was pushed
+                continue;
+            }
+            inTree[id] = true;
+            if (via[id] && sink) {
+                sink(via[id]);
+            } else if (via[id]) {
+                forest.push_back(via[id]);
+            }
+            pair<EdgeIter, EdgeIter> range =
+                graph.getActorById(id)->getEdgesInYears(MIN_YEAR, MAX_YEAR);
+            for (EdgeIter edge = range.first; edge != range.second; edge++) {
+                int dest = (*edge)->getDest()->getId();
+                if (!inTree[dest] && (*edge)->getWeight() < keys[dest]) {
+                    keys[dest] = (*edge)->getWeight();
+                    via[dest] = *edge;
+                    queue.push(dest, keys[dest]);
+                }
+            }
+        }
+        if (start) {
+            // Only the starting actor's tree
+            break;
+        }
+    }
+
+    if (workBytes) {
+        *workBytes = numActors * (sizeof(int) + sizeof(Edge*)) +
+                     numActors / 8 + queue.getPeakBytes();
+    }
+    return forest;
+}
@@ -0,0 +1,41 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of Prim's algorithm with a
+ * bucket queue, which grows a minimum spanning tree one actor at a time.
+ */
+
+#ifndef PRIM_HPP
+#define PRIM_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+/**
+ * Finds a minimum spanning tree with Prim's algorithm. Edge weights are small
+ * integers, so the actors waiting to join the tree are kept in one bucket per
+ * weight instead of a heap, and each actor's edges are read exactly once,
+ * when it joins. Unlike Dijkstra, the weight of the next actor can be lower
+ * than the last one's, so the bucket cursor moves back when a lighter edge is
+ * found. Stale entries are skipped when popped.
+ * Params:
+ * - graph: the graph of all actors
+ * - start: the actor to grow the tree from, or nullptr to grow a tree from
+ *          every actor not yet reached, in id order, giving a forest
+ * - workBytes: if not nullptr, set to the peak bytes of the working arrays
+ * - sink: if set, receives each edge as it is chosen instead of the edges
+ *         being returned
+ * Returns: the edges of the minimum spanning tree or forest, or nothing if
+ *          sink is set
+ */
+vector<Edge*> findPrimForest(ActorGraph& graph, Node* start,
+                             size_t* workBytes = nullptr,
+                             EdgeSink sink = nullptr);
+
+#endif
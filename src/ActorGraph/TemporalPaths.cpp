@@ -0,0 +1,115 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation of the time-respecting
+ * path search, a sweep forward through the years from one actor to many.
+ */
+
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
+
+#include "TemporalPaths.hpp"
+
+/**
+ * Finds time-respecting paths from actor1 to each actor in targets, where the
+ * movies along a path never go back in time. Actors are settled in order of
+ * the earliest year they can be reached, so the search is a single sweep
+ * forward through the years: each actor's year-sorted edges are only scanned
+ * from its arrival year onward, and the sweep stops once every target is
+ * settled.
+ * Params:
+ * - graph: the graph of all actors
+ * - actor1: the name of the actor the paths start from
+ * - targets: the names of the actors the paths end at
+ * - fromYear: the earliest year of a movie the paths may use
+ * - toYear: the latest year of a movie the paths may use
+ * - arrival: scratch space of getNumActors() years set to UNREACHED, which is
+ *            restored before returning
+ * - prev: scratch space of getNumActors() edges into each actor
+ * - mask: the actors and movies the paths must avoid, or nullptr
+ * Returns: a vector of paths, one per target, each ending at the earliest
+ * possible year (empty if the target can't be reached)
+ */
+vector<vector<Edge*>> findTemporalPaths(ActorGraph& graph, string actor1,
+                                        vector<string>& targets, int fromYear,
+                                        int toYear, vector<int>& arrival,
+                                        vector<Edge*>& prev,
+                                        ExclusionMask* mask) {
+    vector<vector<Edge*>> paths(targets.size());
+    Node* start = graph.getActorNode(actor1);
+    if (!start || (mask && mask->excludesActor(start->getId()))) {
+        // start not found or must be avoided
+        return paths;
+    }
+    unordered_map<Node*, int> remaining;  // Targets not yet settled
+    for (int target = 0; target < (int)targets.size(); target++) {
+        Node* end = graph.getActorNode(targets[target]);
+        if (end && end != start &&
+            graph.getComponent(end) == graph.getComponent(start)) {
+            remaining[end] = 1;
+        }
+    }
+
+    // Min heap of actors keyed by the year they are reached
+    priority_queue<pair<int, int>, vector<pair<int, int>>,
+                   greater<pair<int, int>>>
+        sweep;
+    vector<int> reached;  // Actors whose arrival must be reset
+    arrival[start->getId()] = fromYear;
+    reached.push_back(start->getId());
+    sweep.push({fromYear, start->getId()});
+    while (!sweep.empty() && !remaining.empty()) {
+        int year = sweep.top().first;
+        Node* current = graph.getActorById(sweep.top().second);
+        sweep.pop();
+        if (year > arrival[current->getId()]) {
+            // current was already settled at an earlier year
+            continue;
+        }
+        remaining.erase(current);
+
+        // Only movies from the arrival year onward can continue the path
+        pair<EdgeIter, EdgeIter> neighbors =
+            current->getEdgesInYears(year, toYear);
+        for (EdgeIter edge = neighbors.first; edge != neighbors.second;
+             edge++) {
+            int neighbor = (*edge)->getDest()->getId();
+            if (mask && mask->excludes(*edge)) {
+                // Movie or actor must be avoided
+                continue;
+            }
+            if ((*edge)->getYear() < year ||
+                (*edge)->getYear() >= arrival[neighbor]) {
+                // Goes back in time or doesn't reach neighbor any earlier
+                continue;
+            }
+            if (arrival[neighbor] == UNREACHED) {
+                reached.push_back(neighbor);
+            }
+            arrival[neighbor] = (*edge)->getYear();
+            prev[neighbor] = *edge;
+            sweep.push({arrival[neighbor], neighbor});
+        }
+    }
+
+    for (int target = 0; target < (int)targets.size(); target++) {
+        Node* end = graph.getActorNode(targets[target]);
+        if (!end || end == start || arrival[end->getId()] == UNREACHED) {
+            continue;
+        }
+        Node* current = end;
+        while (current != start) {
+            paths[target].push_back(prev[current->getId()]);
+            current = prev[current->getId()]->getSource();
+        }
+        reverse(paths[target].begin(), paths[target].end());
+    }
+    // Resets the actors reached by this sweep
+    for (int actor = 0; actor < (int)reached.size(); actor++) {
+        arrival[reached[actor]] = UNREACHED;
+    }
+    return paths;
+}
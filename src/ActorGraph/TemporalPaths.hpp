@@ -0,0 +1,50 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the time-respecting path
+ * search, a sweep forward through the years from one actor to many.
+ */
+
+#ifndef TEMPORALPATHS_HPP
+#define TEMPORALPATHS_HPP
+
+#include <string>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "ExclusionMask.hpp"
+
+using namespace std;
+
+// Arrival year of an actor that hasn't been reached
+#define UNREACHED (MAX_YEAR + 1)
+
+/**
+ * Finds time-respecting paths from actor1 to each actor in targets, where the
+ * movies along a path never go back in time. Actors are settled in order of
+ * the earliest year they can be reached, so the search is a single sweep
+ * forward through the years: each actor's year-sorted edges are only scanned
+ * from its arrival year onward, and the sweep stops once every target is
+ * settled.
+ * Params:
+ * - graph: the graph of all actors
+ * - actor1: the name of the actor the paths start from
+ * - targets: the names of the actors the paths end at
+ * - fromYear: the earliest year of a movie the paths may use
+ * - toYear: the latest year of a movie the paths may use
+ * - arrival: scratch space of getNumActors() years set to UNREACHED, which is
+ *            restored before returning
+ * - prev: scratch space of getNumActors() edges into each actor
+ * - mask: the actors and movies the paths must avoid, or nullptr
+ * Returns: a vector of paths, one per target, each ending at the earliest
+ * possible year (empty if the target can't be reached)
+ */
+vector<vector<Edge*>> findTemporalPaths(ActorGraph& graph, string actor1,
+                                        vector<string>& targets, int fromYear,
+                                        int toYear, vector<int>& arrival,
+                                        vector<Edge*>& prev,
+                                        ExclusionMask* mask);
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: mmap(2) man page
+ * Description: This file contains the implementation for the TopKIndex.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+
+#include "TopKIndex.hpp"
+
+// Parameters of the 64 bit FNV-1a hash
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+/**
+ * Adds the bytes of a value to an FNV-1a hash
+ * Params:
+ * - hash: the hash so far
+ * - bytes: the first byte of the value
+ * - length: the number of bytes
+ * Returns: the hash with the bytes added
+ */
+static uint64_t hashBytes(uint64_t hash, const void* bytes, size_t length) {
+    const unsigned char* next = (const unsigned char*)bytes;
+    for (size_t byte = 0; byte < length; byte++) {
+        hash = (hash ^ next[byte]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Constructs an index with no file open
+ */
+TopKIndex::TopKIndex() : mapping(nullptr), size(0), header(), slots(nullptr) {}
+
+/**
+ * Unmaps the file, if any
+ */
+TopKIndex::~TopKIndex() {
+    if (mapping) {
+        munmap(mapping, size);
+    }
+}
+
+/**
+ * Maps an index file into memory
+ * Params:
+ * - filename: the name of the file
+ * Returns: true if the file is an index of the expected size
+ */
+bool TopKIndex::open(const char* filename) {
+    int file = ::open(filename, O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(file, &status) < 0 ||
+        (size_t)status.st_size < sizeof(IndexHeader)) {
+        close(file);
+        return false;
+    }
+    size = status.st_size;
+    mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    // The mapping stays valid once the file is closed
+    close(file);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        return false;
+    }
+
+    header = *(const IndexHeader*)mapping;
+    size_t expected = sizeof(IndexHeader) + (size_t)header.numActors * 2 *
+                                                header.k * sizeof(int32_t);
+    if (header.magic != INDEX_MAGIC || header.version != INDEX_VERSION ||
+        header.numActors < 0 || header.k < 0 || size != expected) {
+        munmap(mapping, size);
+        mapping = nullptr;
+        return false;
+    }
+    slots = (const int32_t*)((const char*)mapping + sizeof(IndexHeader));
+    return true;
+}
+
+/**
+ * Returns whether the open index answers for a graph and arguments
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph over the years
+ * - k: the number of actors predicted in each list
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * Returns: true if the index was built from the same
+ */
+bool TopKIndex::matches(ActorGraph& graph, CollabMatrix& matrix, int k,
+                        int fromYear, int toYear) {
+    if (!mapping || header.numActors != graph.getNumActors() ||
+        header.numMovies != graph.getNumMovies() || header.k != k ||
+        header.fromYear != fromYear || header.toYear != toYear) {
+        return false;
+    }
+    // Only hashed once the cheap fields agree
+    return header.fingerprint == fingerprint(graph, matrix);
+}
+
+/**
+ * Reads both lists of an actor
+ * Params:
+ * - actor: the id of the actor
+ * - collabs: filled with the ids of the top collaborators
+ * - uncollabs: filled with the ids of the top new actors
+ * Returns: false if the actor was not indexed
+ */
+bool TopKIndex::lookup(int actor, vector<int>& collabs,
+                       vector<int>& uncollabs) {
+    collabs.clear();
+    uncollabs.clear();
+    if (!mapping || actor < 0 || actor >= header.numActors) {
+        return false;
+    }
+    int k = header.k;
+    const int32_t* slot = slots + (size_t)actor * 2 * k;
+    if (k > 0 && slot[0] == MISSING_SLOT) {
+        return false;
+    }
+    for (int rank = 0; rank < k && slot[rank] != EMPTY_SLOT; rank++) {
+        collabs.push_back(slot[rank]);
+    }
+    for (int rank = 0; rank < k && slot[k + rank] != EMPTY_SLOT; rank++) {
+        uncollabs.push_back(slot[k + rank]);
+    }
+    return true;
+}
+
+/**
+ * Returns the header of an index of a graph
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph over the years
+ * - k: the number of actors predicted in each list
+ * - fromYear: the earliest year of a movie counted
+ * - toYear: the latest year of a movie counted
+ * Returns: the header
+ */
+IndexHeader TopKIndex::makeHeader(ActorGraph& graph, CollabMatrix& matrix,
+                                  int k, int fromYear, int toYear) {
+    IndexHeader header = IndexHeader();
+    header.magic = INDEX_MAGIC;
+    header.version = INDEX_VERSION;
+    header.numActors = graph.getNumActors();
+    header.numMovies = graph.getNumMovies();
+    header.k = k;
+    header.fromYear = fromYear;
+    header.toYear = toYear;
+    header.fingerprint = fingerprint(graph, matrix);
+    return header;
+}
+
+/**
+ * Returns a hash of what the lists of a graph are predicted from: the name
+ * of every actor in order of id, which also breaks ties, and every row of
+ * the collaboration matrix
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph
+ * Returns: the 64 bit FNV-1a hash
+ */
+uint64_t TopKIndex::fingerprint(ActorGraph& graph, CollabMatrix& matrix) {
+    uint64_t hash = FNV_OFFSET;
+    for (int actor = 0; actor < graph.getNumActors(); actor++) {
+        // The terminating null keeps adjacent names apart
+        string name = graph.getActorById(actor)->getName();
+        hash = hashBytes(hash, name.c_str(), name.size() + 1);
+    }
+    for (int row = 0; row < matrix.getNumRows(); row++) {
+        int32_t length = matrix.getRowLength(row);
+        hash = hashBytes(hash, &length, sizeof(length));
+        hash = hashBytes(hash, matrix.getColumns(row), length * sizeof(int));
+        hash = hashBytes(hash, matrix.getValues(row), length * sizeof(int));
+    }
+    return hash;
+}
+
+/**
+ * Writes an index file
+ * Params:
+ * - filename: the name of the file
+ * - header: the header of the index
+ * - slots: 2 * k slots per actor id
+ * Returns: the number of bytes written, or 0 if the file could not be
+ *          written
+ */
+size_t TopKIndex::write(const char* filename, const IndexHeader& header,
+                        const vector<int32_t>& slots) {
+    ofstream output(filename, ios::binary | ios::trunc);
+    output.write((const char*)&header, sizeof(IndexHeader));
+    output.write((const char*)slots.data(), slots.size() * sizeof(int32_t));
+    output.close();
+    if (!output) {
+        return 0;
+    }
+    return sizeof(IndexHeader) + slots.size() * sizeof(int32_t);
+}
@@ -0,0 +1,145 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: mmap(2) man page
+ * Description: This file contains the declaration of the TopKIndex, a file of
+ * both predicted lists of every actor that is read back by mapping it into
+ * memory.
+ */
+
+#ifndef TOPKINDEX_HPP
+#define TOPKINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ActorGraph.hpp"
+#include "CollabMatrix.hpp"
+
+using namespace std;
+
+// First bytes of every index file, and the version of its layout
+#define INDEX_MAGIC 0x58494b4c  // "LKIX"
+#define INDEX_VERSION 2
+
+// Slot of a list shorter than k, and the slots of an actor not indexed
+#define EMPTY_SLOT -1
+#define MISSING_SLOT -2
+
+/*
+ * What an index was built from. A file only answers for a graph and
+ * arguments with the same header, since actor ids follow the order the
+ * graph was loaded in. The counts alone miss a graph with rows reordered or
+ * changed in place, so the header also keeps a fingerprint of the names in
+ * order of id and of every row of the collaboration matrix.
+ */
+struct IndexHeader {
+    uint32_t magic;     // INDEX_MAGIC
+    uint32_t version;   // INDEX_VERSION
+    int32_t numActors;  // Actors in the graph, each with 2 * k slots
+    int32_t numMovies;  // Movies in the graph
+    int32_t k;          // Actors predicted in each list
+    int32_t fromYear;   // Earliest year of a movie counted
+    int32_t toYear;     // Latest year of a movie counted
+    int32_t padding;    // Keeps the fingerprint 8 byte aligned
+    uint64_t fingerprint;  // Hash of the names and the matrix rows
+};
+
+/**
+ * This class answers both predicted lists of an actor from a file written by
+ * an offline job. After the header, every actor id has 2 * k slots: the ids
+ * of its top collaborators, then of its top new actors, each padded with
+ * EMPTY_SLOT. An actor that was not indexed has MISSING_SLOT in every slot.
+ * Since every actor's lists are at a fixed place, a lookup reads only their
+ * slots, and the file is mapped rather than read so that opening it costs
+ * nothing and only the pages of actors looked up are ever loaded.
+ */
+class TopKIndex {
+  private:
+    void* mapping;         // The mapped file, or null
+    size_t size;           // The length of the file in bytes
+    IndexHeader header;    // The header of the file
+    const int32_t* slots;  // 2 * k slots per actor id
+
+  public:
+    /**
+     * Constructs an index with no file open
+     */
+    TopKIndex();
+
+    /**
+     * Unmaps the file, if any
+     */
+    ~TopKIndex();
+
+    /**
+     * Maps an index file into memory
+     * Params:
+     * - filename: the name of the file
+     * Returns: true if the file is an index of the expected size
+     */
+    bool open(const char* filename);
+
+    /**
+     * Returns whether the open index answers for a graph and arguments
+     * Params:
+     * - graph: the graph of all actors
+     * - matrix: the collaboration matrix of the graph over the years
+     * - k: the number of actors predicted in each list
+     * - fromYear: the earliest year of a movie to count
+     * - toYear: the latest year of a movie to count
+     * Returns: true if the index was built from the same
+     */
+    bool matches(ActorGraph& graph, CollabMatrix& matrix, int k, int fromYear,
+                 int toYear);
+
+    /**
+     * Reads both lists of an actor
+     * Params:
+     * - actor: the id of the actor
+     * - collabs: filled with the ids of the top collaborators
+     * - uncollabs: filled with the ids of the top new actors
+     * Returns: false if the actor was not indexed
+     */
+    bool lookup(int actor, vector<int>& collabs, vector<int>& uncollabs);
+
+    /**
+     * Returns the header of an index of a graph
+     * Params:
+     * - graph: the graph of all actors
+     * - matrix: the collaboration matrix of the graph over the years
+     * - k: the number of actors predicted in each list
+     * - fromYear: the earliest year of a movie counted
+     * - toYear: the latest year of a movie counted
+     * Returns: the header
+     */
+    static IndexHeader makeHeader(ActorGraph& graph, CollabMatrix& matrix,
+                                  int k, int fromYear, int toYear);
+
+    /**
+     * Returns a hash of what the lists of a graph are predicted from: the
+     * name of every actor in order of id, which also breaks ties, and every
+     * row of the collaboration matrix
+     * Params:
+     * - graph: the graph of all actors
+     * - matrix: the collaboration matrix of the graph
+     * Returns: the 64 bit FNV-1a hash
+     */
+    static uint64_t fingerprint(ActorGraph& graph, CollabMatrix& matrix);
+
+    /**
+     * Writes an index file
+     * Params:
+     * - filename: the name of the file
+     * - header: the header of the index
+     * - slots: 2 * k slots per actor id
+     * Returns: the number of bytes written, or 0 if the file could not be
+     *          written
+     */
+    static size_t write(const char* filename, const IndexHeader& header,
+                        const vector<int32_t>& slots);
+};
+
+#endif
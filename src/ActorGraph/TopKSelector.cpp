@@ -0,0 +1,36 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for the TopKSelector.
+ */
+
+#include "TopKSelector.hpp"
+
+/**
+ * Constructs an empty selector
+ * Params:
+ * - nameRanks: the alphabetical rank of each actor id's name
+ * - k: the number of candidates to keep
+ */
+TopKSelector::TopKSelector(const vector<int>& nameRanks, int k)
+    : nameRanks(nameRanks), k(k) {}
+
+/**
+ * Returns the ids of the best candidates and empties the selector
+ * Params: None
+ * Returns: the ids, best first
+ */
+vector<int> TopKSelector::takeTop() {
+    sort(heap.begin(), heap.end(),
+         [this](const Candidate& left, const Candidate& right) {
+             return isBetter(left, right);
+         });
+    vector<int> top;
+    for (int rank = 0; rank < (int)heap.size(); rank++) {
+        top.push_back(heap[rank].second);
+    }
+    heap.clear();
+    return top;
+}
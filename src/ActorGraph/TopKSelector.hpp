@@ -0,0 +1,89 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of the TopKSelector, which
+ * keeps the best k scored actors without sorting all of them.
+ */
+
+#ifndef TOPKSELECTOR_HPP
+#define TOPKSELECTOR_HPP
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// A score and the id of the actor it belongs to
+typedef pair<double, int> Candidate;
+
+/**
+ * This class keeps the k best of a stream of scored actor ids in a bounded
+ * heap whose root is the worst one kept, so each offer costs at most
+ * logarithmic time in k. Candidates are ranked by score, highest first, then
+ * by name in alphabetical order, which is compared through each actor's
+ * precomputed rank among all names so names are only looked up for the
+ * winners.
+ */
+class TopKSelector {
+  private:
+    const vector<int>& nameRanks;  // Alphabetical rank of each actor's name
+    int k;                         // Number of candidates to keep
+    vector<Candidate> heap;        // The best candidates, worst at the front
+
+  public:
+    /**
+     * Constructs an empty selector
+     * Params:
+     * - nameRanks: the alphabetical rank of each actor id's name
+     * - k: the number of candidates to keep
+     */
+    TopKSelector(const vector<int>& nameRanks, int k);
+
+    /**
+     * Returns whether one candidate ranks above another
+     * Params:
+     * - left: a candidate
+     * - right: another candidate
+     * Returns: true if left has the higher score, or the same score and the
+     *          earlier name
+     */
+    bool isBetter(const Candidate& left, const Candidate& right) const {
+        if (left.first != right.first) {
+            return left.first > right.first;
+        }
+        return nameRanks[left.second] < nameRanks[right.second];
+    }
+
+    /**
+     * Considers a candidate, keeping it if it is among the best k so far
+     * Params:
+     * - score: the candidate's score
+     * - id: the candidate's actor id
+     * Returns: void
+     */
+    void offer(double score, int id) {
+        Candidate candidate(score, id);
+        auto comp = [this](const Candidate& left, const Candidate& right) {
+            return isBetter(left, right);
+        };
+        if ((int)heap.size() < k) {
+            heap.push_back(candidate);
+            push_heap(heap.begin(), heap.end(), comp);
+        } else if (k > 0 && isBetter(candidate, heap.front())) {
+            pop_heap(heap.begin(), heap.end(), comp);
+            heap.back() = candidate;
+            push_heap(heap.begin(), heap.end(), comp);
+        }
+    }
+
+    /**
+     * Returns the ids of the best candidates and empties the selector
+     * Params: None
+     * Returns: the ids, best first
+     */
+    vector<int> takeTop();
+};
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation of runWorkers, which
+ * runs the same work on several threads and waits for all of them.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "Workers.hpp"
+
+/**
+ * Runs a worker on numThreads threads, each given its index from 0 to
+ * numThreads - 1, and waits for all of them. Worker 0 runs on the calling
+ * thread, so one thread starts no new ones.
+ * Params:
+ * - numThreads: the number of threads, at least one
+ * - worker: the work of one thread, given its index
+ * Returns: void
+ */
+void runWorkers(int numThreads, const function<void(int)>& worker) {
+    vector<thread> threads;
+    for (int part = 1; part < numThreads; part++) {
+        threads.push_back(thread(worker, part));
+    }
+    worker(0);
+    for (int part = 0; part < (int)threads.size(); part++) {
+        threads[part].join();
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the declaration of runWorkers, which runs
+ * the same work on several threads and waits for all of them.
+ */
+
+#ifndef WORKERS_HPP
+#define WORKERS_HPP
+
+#include <functional>
+
+using namespace std;
+
+/**
+ * Runs a worker on numThreads threads, each given its index from 0 to
+ * numThreads - 1, and waits for all of them. Worker 0 runs on the calling
+ * thread, so one thread starts no new ones.
+ * Params:
+ * - numThreads: the number of threads, at least one
+ * - worker: the work of one thread, given its index
+ * Returns: void
+ */
+void runWorkers(int numThreads, const function<void(int)>& worker);
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for intersectbench,
+ * which times every sorted array intersection kernel across size ratios.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Intersect.hpp"
+#include "Options.hpp"
+#include "cxxopts.hpp"
+
+using namespace std;
+
+// Seed of the random arrays, so every run times the same ones
+#define SEED 2019
+
+// Ids are drawn from this many times the length of the longer array
+#define SPREAD 2
+
+// A kernel and the name it is reported by
+typedef int (*Kernel)(const int*, int, const int*, int, int*);
+typedef pair<const char*, Kernel> NamedKernel;
+
+/**
+ * Returns a sorted array of distinct random ids
+ * Params:
+ * - length: the number of ids
+ * - range: ids are drawn from zero up to this
+ * - random: the random number generator
+ * Returns: the ids, in increasing order
+ */
+vector<int> randomIds(int length, int range, mt19937& random) {
+    uniform_int_distribution<int> pick(0, range - 1);
+    vector<int> ids;
+    while ((int)ids.size() < length) {
+        ids.push_back(pick(random));
+        if ((int)ids.size() == length) {
+            sort(ids.begin(), ids.end());
+            ids.erase(unique(ids.begin(), ids.end()), ids.end());
+        }
+    }
+    return ids;
+}
+
+/**
+ * Times every kernel intersecting a short array with ones from as long to
+ * maxRatio times longer, doubling each time, and reports the nanoseconds per
+ * intersection to standard out
+ * Params:
+ *  - argc: the number of command line arguments
+ *  - argv: contents of the command line arguments. Optionally --length sets
+ *          the length of the short array, --max-ratio the largest size ratio
+ *          and --repeats how many times each intersection is timed.
+ *  Returns: 0 if every kernel found the same intersections, otherwise 1
+ */
+int main(int argc, char* argv[]) {
+    cxxopts::Options options(argv[0], "Times sorted array intersections");
+    options.add_options()("length", "Length of the shorter array",
+                          cxxopts::value<int>()->default_value("1000"))(
+        "max-ratio", "Largest ratio of the longer array to the shorter",
+        cxxopts::value<int>()->default_value("1024"))(
+        "repeats", "Times each intersection is run",
+        cxxopts::value<int>()->default_value("100"));
+    unique_ptr<cxxopts::ParseResult> parsed = parseOptions(options, argc, argv);
+    if (!parsed) {
+        return EXIT_FAILURE;
+    }
+    cxxopts::ParseResult& args = *parsed;
+    int length = max(1, args["length"].as<int>());
+    int maxRatio = max(1, args["max-ratio"].as<int>());
+    int repeats = max(1, args["repeats"].as<int>());
+
+    vector<NamedKernel> kernels = {{"merge", intersectMerge},
+                                   {"gallop", intersectGallop},
+                                   {"sse", intersectSSE}};
+    if (hasAVX2()) {
+        kernels.push_back({"avx2", intersectAVX2});
+    }
+    kernels.push_back({"auto", intersect});
+
+    mt19937 random(SEED);
+    bool agree = true;
+    for (int ratio = 1; ratio <= maxRatio; ratio *= 2) {
+        int longLength = length * ratio;
+        vector<int> shorter = randomIds(length, longLength * SPREAD, random);
+        vector<int> longer = randomIds(longLength, longLength * SPREAD, random);
+        vector<int> matches(length);
+        cout << "ratio: " << ratio;
+        int expected = -1;
+        for (NamedKernel& kernel : kernels) {
+            int shared = 0;
+            chrono::steady_clock::time_point begin =
+                chrono::steady_clock::now();
+            for (int repeat = 0; repeat < repeats; repeat++) {
+                shared = kernel.second(shorter.data(), shorter.size(),
+                                       longer.data(), longer.size(),
+                                       matches.data());
+            }
+            double nanoseconds = chrono::duration<double, nano>(
+                                     chrono::steady_clock::now() - begin)
+                                     .count() /
+                                 repeats;
+            cout << " " << kernel.first << " ns: " << nanoseconds;
+            if (expected < 0) {
+                expected = shared;
+            } else if (shared != expected) {
+                cerr << kernel.first << " found " << shared << " shared ids, "
+                     << "merge found " << expected << endl;
+                agree = false;
+            }
+        }
+        cout << " shared: " << expected << endl;
+    }
+    return agree ? EXIT_SUCCESS : EXIT_FAILURE;
+}
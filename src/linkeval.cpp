@@ -0,0 +1,213 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: Liben-Nowell and Kleinberg, "The Link Prediction Problem for
+ * Social Networks"
+ * Description: This file contains the implementation for link eval, which
+ * measures how well and how fast each scoring model predicts the
+ * collaborations that happen after a year from the movies up to it.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "ActorGraph.hpp"
+#include "CollabMatrix.hpp"
+#include "LinkPredictor.hpp"
+#include "Options.hpp"
+#include "cxxopts.hpp"
+
+using namespace std;
+
+// Command line argument positions
+#define MOVIE_FILE 1
+
+// Seed of the sample of actors, so every run measures the same ones
+#define SEED 2019
+
+// Default number of actors predicted
+#define SAMPLE_SIZE 1000
+
+/*
+ * Hits and sizes summed over the sampled actors for one list, from which its
+ * precision at k and recall at k are read
+ */
+struct ListScore {
+    double precision = 0;  // Sum of hits over k
+    double recall = 0;     // Sum of hits over actual collaborators
+    int numRecalled = 0;   // Actors with any actual collaborator
+};
+
+/**
+ * Counts how many of the predicted actors are among the actual ones
+ * Params:
+ * - predicted: the predicted ids
+ * - actual: the actual ids, in increasing order
+ * Returns: the number of predicted ids that are actual
+ */
+int countHits(const vector<int>& predicted, const vector<int>& actual) {
+    int hits = 0;
+    for (int id : predicted) {
+        hits += binary_search(actual.begin(), actual.end(), id);
+    }
+    return hits;
+}
+
+/**
+ * Adds one actor's hits to the score of a list
+ * Params:
+ * - score: the score of the list
+ * - predicted: the predicted ids
+ * - actual: the actual ids, in increasing order
+ * - k: the number of actors predicted in each list
+ * Returns: void
+ */
+void addScore(ListScore& score, const vector<int>& predicted,
+              const vector<int>& actual, int k) {
+    int hits = countHits(predicted, actual);
+    score.precision += k ? (double)hits / k : 0;
+    if (!actual.empty()) {
+        score.recall += (double)hits / actual.size();
+        score.numRecalled++;
+    }
+}
+
+/**
+ * Predicts a sample of actors from the movies up to a year under each
+ * scoring model and checks the lists against the collaborations after it.
+ * Collaborators are scored against the ones who work with the actor again,
+ * new actors against the first collaborations. Reports the mean precision at
+ * k and recall at k of both lists and the predictions per second of each
+ * model to standard out.
+ * Params:
+ *  - argc: the number of command line arguments (should be 1)
+ *  - argv: contents of the command line arguments: should be name of file
+ *          containing movie casts. --year is the last year predicted from.
+ *          Optionally --sample sets how many actors are predicted, --top-k
+ *          how many actors are in each list, --model which models to
+ *          measure and --threads how many threads predict.
+ *  Returns: 0 if success, otherwise 1
+ */
+int main(int argc, char* argv[]) {
+    string allModels = MODEL_NAMES[0];
+    for (int model = 1; model < NUM_MODELS; model++) {
+        allModels += string(",") + MODEL_NAMES[model];
+    }
+    cxxopts::Options options(argv[0], "Evaluates the link predictor");
+    options.add_options()(
+        "year", "Predict from movies up to this year, check against later",
+        cxxopts::value<int>())(
+        "sample", "Number of actors with movies on both sides of the year",
+        cxxopts::value<int>()->default_value(to_string(SAMPLE_SIZE)))(
+        "top-k", "Number of actors to predict for each actor",
+        cxxopts::value<int>()->default_value(to_string(TOP_RANK)))(
+        "model", "Scoring models to measure, comma separated",
+        cxxopts::value<vector<string>>()->default_value(allModels))(
+        "threads", "Number of threads to use",
+        cxxopts::value<int>()->default_value(
+            to_string(max(1, (int)thread::hardware_concurrency()))));
+    unique_ptr<cxxopts::ParseResult> parsed = parseOptions(options, argc, argv);
+    if (!parsed) {
+        return EXIT_FAILURE;
+    }
+    cxxopts::ParseResult& args = *parsed;
+    if (argc <= MOVIE_FILE || !args.count("year")) {
+        cerr << "Usage: " << argv[0] << " movie_file --year year" << endl;
+        return EXIT_FAILURE;
+    }
+    int year = args["year"].as<int>();
+    int sampleSize = max(1, args["sample"].as<int>());
+    int k = args["top-k"].as<int>();
+    if (k < 1) {
+        cerr << "--top-k must be at least 1" << endl << options.help() << endl;
+        return EXIT_FAILURE;
+    }
+    int numThreads = max(1, args["threads"].as<int>());
+    vector<string> modelNames = args["model"].as<vector<string>>();
+    vector<int> models;
+    for (string& name : modelNames) {
+        models.push_back(findModel(name));
+        if (models.back() < 0) {
+            cerr << "Unknown model " << name << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    ActorGraph graph;
+    if (!graph.loadFromFile(argv[MOVIE_FILE], false)) {
+        return EXIT_FAILURE;
+    }
+    CollabMatrix past(graph, MIN_YEAR, year);
+    CollabMatrix future(graph, year + 1, MAX_YEAR);
+    vector<int> nameRanks = graph.getNameRanks();
+
+    // Only actors with collaborators on both sides can be predicted and
+    // checked
+    vector<int> sample;
+    for (int actor = 0; actor < graph.getNumActors(); actor++) {
+        if (past.getRowLength(actor) > 0 && future.getRowLength(actor) > 0) {
+            sample.push_back(actor);
+        }
+    }
+    mt19937 random(SEED);
+    shuffle(sample.begin(), sample.end(), random);
+    sample.resize(min((int)sample.size(), sampleSize));
+    if (sample.empty()) {
+        cerr << "No actor has movies both up to and after " << year << endl;
+        return EXIT_FAILURE;
+    }
+
+    // Splits each actor's later collaborators into old and new ones
+    vector<vector<int>> again(sample.size());
+    vector<vector<int>> first(sample.size());
+    for (int query = 0; query < (int)sample.size(); query++) {
+        int actor = sample[query];
+        const int* known = past.getColumns(actor);
+        int numKnown = past.getRowLength(actor);
+        const int* later = future.getColumns(actor);
+        for (int entry = 0; entry < future.getRowLength(actor); entry++) {
+            bool old = binary_search(known, known + numKnown, later[entry]);
+            (old ? again : first)[query].push_back(later[entry]);
+        }
+    }
+    cout << "year: " << year << " actors: " << sample.size() << " k: " << k
+         << " threads: " << numThreads << endl;
+
+    for (int model = 0; model < (int)models.size(); model++) {
+        vector<vector<int>> collabs;
+        vector<vector<int>> uncollabs;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        predictIdsParallel(graph, past, nameRanks, k, sample, models[model],
+                           numThreads, collabs, uncollabs);
+        double seconds = chrono::duration<double>(
+                             chrono::steady_clock::now() - begin)
+                             .count();
+
+        ListScore oldScore;
+        ListScore newScore;
+        for (int query = 0; query < (int)sample.size(); query++) {
+            addScore(oldScore, collabs[query], again[query], k);
+            addScore(newScore, uncollabs[query], first[query], k);
+        }
+        cout << "model: " << modelNames[model]
+             << " collaborator precision@" << k << ": "
+             << oldScore.precision / sample.size() << " recall@" << k << ": "
+             << (oldScore.numRecalled
+                     ? oldScore.recall / oldScore.numRecalled
+                     : 0)
+             << " new precision@" << k << ": "
+             << newScore.precision / sample.size() << " recall@" << k << ": "
+             << (newScore.numRecalled
+                     ? newScore.recall / newScore.numRecalled
+                     : 0)
+             << " predictions per second: "
+             << (seconds > 0 ? sample.size() / seconds : 0) << endl;
+    }
+    graph.clear();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the implementation for link index, which
+ * predicts both lists of every actor ahead of time and writes them to a
+ * TopKIndex that link predictor answers from.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "ActorGraph.hpp"
+#include "CollabMatrix.hpp"
+#include "LinkPredictor.hpp"
+#include "Options.hpp"
+#include "TopKIndex.hpp"
+#include "cxxopts.hpp"
+
+using namespace std;
+
+// Command line argument positions
+#define MOVIE_FILE 1
+#define INDEX_FILE 2
+
+/**
+ * Returns the ids of the actors named in a file, one per line after a header
+ * line, skipping names not in the graph
+ * Params:
+ * - graph: the graph of all actors
+ * - actorFile: name of file containing actors
+ * Returns: the ids of the actors, each once and in increasing order
+ */
+vector<int> parseActors(ActorGraph& graph, string actorFile) {
+    ifstream infile(actorFile);
+    vector<int> ids;
+    string line;
+    // skip the header
+    getline(infile, line);
+    while (getline(infile, line)) {
+        Node* node = graph.getActorNode(line);
+        if (node) {
+            ids.push_back(node->getId());
+        }
+    }
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+/**
+ * Predicts both weighted lists of actors with predictIdsParallel into the
+ * slots of an index
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix of the graph over the years
+ * - ids: the ids of the actors to be predicted
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads to use
+ * - slots: filled with 2 * k slots per actor id, MISSING_SLOT for actors not
+ *   predicted
+ * Returns: void
+ */
+void predictSlots(ActorGraph& graph, CollabMatrix& matrix,
+                  const vector<int>& ids, int k, int numThreads,
+                  vector<int32_t>& slots) {
+    vector<vector<int>> collabs;
+    vector<vector<int>> uncollabs;
+    predictIdsParallel(graph, matrix, graph.getNameRanks(), k, ids,
+                       WEIGHTED_MODEL, numThreads, collabs, uncollabs);
+    slots.assign((size_t)graph.getNumActors() * 2 * k, MISSING_SLOT);
+    for (int query = 0; query < (int)ids.size(); query++) {
+        int32_t* slot = &slots[(size_t)ids[query] * 2 * k];
+        fill_n(slot, 2 * k, EMPTY_SLOT);
+        copy(collabs[query].begin(), collabs[query].end(), slot);
+        copy(uncollabs[query].begin(), uncollabs[query].end(), slot + k);
+    }
+}
+
+/**
+ * Builds the index of predictions that link predictor answers from with
+ * --index, and reports how long it took and how large it is to standard out
+ * Params:
+ *  - argc: the number of command line arguments (should be 2)
+ *  - argv: contents of the command line arguments: should be name of file
+ *          containing movie casts and name of the index file to write.
+ *          Optionally --from-year, --to-year and --top-k must be given as
+ *          they will be to link predictor, --threads sets how many threads
+ *          predict and --actors only indexes the actors of a file.
+ *  Returns: 0 if success, otherwise 1
+ */
+int main(int argc, char* argv[]) {
+    cxxopts::Options options(argv[0], "Indexes predicted collaborators");
+    options.add_options()(
+        "from-year", "Only count movies from this year or later",
+        cxxopts::value<int>()->default_value(to_string(MIN_YEAR)))(
+        "to-year", "Only count movies from this year or earlier",
+        cxxopts::value<int>()->default_value(to_string(MAX_YEAR)))(
+        "top-k", "Number of actors to predict for each actor",
+        cxxopts::value<int>()->default_value(to_string(TOP_RANK)))(
+        "threads", "Number of threads to use",
+        cxxopts::value<int>()->default_value(
+            to_string(max(1, (int)thread::hardware_concurrency()))))(
+        "actors", "File of the actors to index, one per line after a header",
+        cxxopts::value<string>());
+    unique_ptr<cxxopts::ParseResult> parsed = parseOptions(options, argc, argv);
+    if (!parsed) {
+        return EXIT_FAILURE;
+    }
+    cxxopts::ParseResult& args = *parsed;
+    if (argc <= INDEX_FILE) {
+        cerr << "Usage: " << argv[0] << " movie_file index_file" << endl;
+        return EXIT_FAILURE;
+    }
+    int fromYear = args["from-year"].as<int>();
+    int toYear = args["to-year"].as<int>();
+    int k = args["top-k"].as<int>();
+    if (k < 1) {
+        cerr << "--top-k must be at least 1" << endl << options.help() << endl;
+        return EXIT_FAILURE;
+    }
+    int numThreads = max(1, args["threads"].as<int>());
+
+    ActorGraph graph;
+    graph.loadFromFile(argv[MOVIE_FILE], false);
+    vector<int> ids;
+    if (args.count("actors")) {
+        ids = parseActors(graph, args["actors"].as<string>());
+    } else {
+        for (int actor = 0; actor < graph.getNumActors(); actor++) {
+            ids.push_back(actor);
+        }
+    }
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    CollabMatrix matrix(graph, fromYear, toYear);
+    vector<int32_t> slots;
+    predictSlots(graph, matrix, ids, k, numThreads, slots);
+    size_t bytes = TopKIndex::write(
+        argv[INDEX_FILE],
+        TopKIndex::makeHeader(graph, matrix, k, fromYear, toYear), slots);
+    double seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    if (!bytes) {
+        cerr << "Could not write " << argv[INDEX_FILE] << endl;
+        return EXIT_FAILURE;
+    }
+    cout << "actors indexed: " << ids.size() << " of "
+         << graph.getNumActors() << " seconds: " << seconds
+         << " bytes: " << bytes << " bytes per actor: "
+         << (graph.getNumActors() ? bytes / graph.getNumActors() : 0) << endl;
+    graph.clear();
+    return EXIT_SUCCESS;
+}
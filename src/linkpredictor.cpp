@@ -8,12 +8,24 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <sstream>
+#include <thread>
 
 #include "ActorGraph.hpp"
+#include "CollabMatrix.hpp"
+#include "IncrementalPredictor.hpp"
+#include "LinkPredictor.hpp"
+#include "MinHashIndex.hpp"
+#include "Options.hpp"
+#include "TopKIndex.hpp"
+#include "Workers.hpp"
+#include "cxxopts.hpp"
 
 // command line argument positions
 #define MOVIE_FILE 1
@@ -21,196 +33,774 @@
 #define COLLAB_FILE 3
 #define UNCOLLAB_FILE 4
 
-// Top rank 4 is printed
-#define TOP_RANK 4
+// command line argument positions with --score-pairs
+#define PAIR_FILE 2
+#define SCORE_FILE 3
 
-#define HEADER1 "Actor1,Actor2,Actor3,Actor4"
-#define HEADER2 "Actor1,Actor2,Actor3,Actor4"
+// Each column of the headers is numbered, "Actor1,Actor2,..."
+#define HEADER_COLUMN "Actor"
+#define HEADER_DELIM ','
 
 // Tabs between actors
 #define ACTOR_DELIM '\t'
 
-bool compare(pair<string, int> left, pair<string, int> right);
+// Score written under every model for a pair with an actor not in the graph
+#define MISSING_SCORE "nan"
+
+// Ways of scoring the candidates of every actor
+#define HASH_ENGINE "hash"      // Hash maps of collaborators, one actor at a time
+#define SPGEMM_ENGINE "spgemm"  // Rows of the squared collaboration matrix
+#define SPA_ENGINE "spa"        // One pass per actor into a dense accumulator
+#define INTERSECT_ENGINE "intersect"  // Sorted rows intersected per candidate
+
+// Every engine, in the order they are benchmarked
+const char* const ENGINES[] = {HASH_ENGINE, SPGEMM_ENGINE, SPA_ENGINE,
+                               INTERSECT_ENGINE};
+
+// Times each actor is predicted when measuring latency
+#define LATENCY_REPEATS 10
+
+// Default number of collaborators from which the approximate mode applies
+#define HUB_DEGREE 1000
+
+// Names of the ways of capping hubs
+#define SKIP_POLICY "skip"
+#define SAMPLE_POLICY "sample"
+
+// Ends the lines of actors whose prediction hit a work limit
+#define TRUNCATED_FLAG "#TRUNCATED"
 
 /**
- * Predicts the top four actors that are most likely to be in the next movie
- * with actor out of those who already collaborated with the actor
+ * Predicts both lists for many actors at once from rows of A * A, where A is
+ * the collaboration matrix. The score predictCollaborate gives collaborator c
+ * of actor a is the sum over their shared collaborators n of A[a][n] *
+ * A[n][c], which is (A * A)[a][c], and the score predictNew gives an actor u
+ * two steps away is (A * A)[a][u] likewise. Each row of the product is
+ * merged with the actor's row of A to split collaborators from new actors,
+ * and reduced to its top actors on the thread that computed it.
  * Params:
  * - graph: the graph of all actors
- * - actorName: name of actor to be predicted
- * Returns: top four actors in next movie (out of collaborators)
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads to use
+ * - collabs: filled with the top collaborators of each actor
+ * - uncollabs: filled with the top new collaborators of each actor
+ * Returns: void
  */
-vector<string> predictCollaborate(ActorGraph& graph, string actorName) {
-    Node* actor = graph.getActorNode(actorName);
-    vector<Edge*> edges = actor->getEdges();
-    unordered_map<Node*, int> collaborators;
-    // Finds all collaborators and number of movies both are in
-    for (int edge = 0; edge < edges.size(); edge++) {
-        if (collaborators.find(edges[edge]->getDest()) == collaborators.end()) {
-            // collaborator not in map
-            collaborators.insert({edges[edge]->getDest(), 1});
+void predictBatch(ActorGraph& graph, vector<string>& actors, int fromYear,
+                  int toYear, const vector<int>& nameRanks, int k,
+                  int numThreads, vector<vector<string>>& collabs,
+                  vector<vector<string>>& uncollabs) {
+    CollabMatrix matrix(graph, fromYear, toYear);
+    vector<int> rows;
+    vector<int> queries;  // Index in actors of each row
+    for (int actor = 0; actor < (int)actors.size(); actor++) {
+        Node* node = graph.getActorNode(actors[actor]);
+        if (node) {
+            rows.push_back(node->getId());
+            queries.push_back(actor);
+        }
+    }
+    collabs.assign(actors.size(), {});
+    uncollabs.assign(actors.size(), {});
+
+    matrix.multiplyRows(rows, numThreads, [&](int query,
+                                              vector<Entry>& product) {
+        int row = rows[query];
+        vector<Entry> collaborators = matrix.getRow(row);
+        TopKSelector oldScores(nameRanks, k);
+        TopKSelector newScores(nameRanks, k);
+        // Both rows are in order of column, so they are merged
+        int next = 0;
+        for (Entry& entry : product) {
+            while (next < (int)collaborators.size() &&
+                   collaborators[next].first < entry.first) {
+                // Collaborator with no collaborators in common
+                oldScores.offer(0, collaborators[next++].first);
+            }
+            if (next < (int)collaborators.size() &&
+                collaborators[next].first == entry.first) {
+                oldScores.offer(entry.second, entry.first);
+                next++;
+            } else if (entry.first != row) {
+                newScores.offer(entry.second, entry.first);
+            }
+        }
+        for (; next < (int)collaborators.size(); next++) {
+            oldScores.offer(0, collaborators[next].first);
+        }
+        collabs[queries[query]] = getNames(graph, oldScores.takeTop());
+        uncollabs[queries[query]] = getNames(graph, newScores.takeTop());
+    });
+}
+
+/**
+ * Predicts both lists for many actors under several models with the fused
+ * LinkPredictor under work limits. Unlike predictIdsParallel it keeps every
+ * model's lists, by name, and whether each prediction was truncated.
+ * Params:
+ * - graph: the graph of all actors
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - models: the numbers of the scoring models
+ * - limits: bounds on the work of each prediction
+ * - numThreads: the number of threads to use
+ * - collabs: filled with the top collaborators of each actor, per model
+ * - uncollabs: filled with the top new collaborators of each actor, per model
+ * - truncated: filled with whether each actor's prediction hit a limit
+ * Returns: void
+ */
+void predictModels(ActorGraph& graph, vector<string>& actors, int fromYear,
+                   int toYear, const vector<int>& nameRanks, int k,
+                   const vector<int>& models, WorkLimits limits,
+                   int numThreads, vector<vector<vector<string>>>& collabs,
+                   vector<vector<vector<string>>>& uncollabs,
+                   vector<char>& truncated) {
+    CollabMatrix matrix(graph, fromYear, toYear);
+    collabs.assign(models.size(), vector<vector<string>>(actors.size()));
+    uncollabs.assign(models.size(), vector<vector<string>>(actors.size()));
+    truncated.assign(actors.size(), false);
+    atomic<int> nextActor(0);
+    auto worker = [&](int) {
+        LinkPredictor predictor(graph, matrix, nameRanks, k, limits);
+        vector<vector<string>> modelCollabs;
+        vector<vector<string>> modelUncollabs;
+        for (int actor = nextActor++; actor < (int)actors.size();
+             actor = nextActor++) {
+            Node* node = graph.getActorNode(actors[actor]);
+            if (!node) {
+                continue;
+            }
+            predictor.predict(node->getId(), models, modelCollabs,
+                              modelUncollabs);
+            truncated[actor] = predictor.wasTruncated();
+            for (int model = 0; model < (int)models.size(); model++) {
+                collabs[model][actor] = move(modelCollabs[model]);
+                uncollabs[model][actor] = move(modelUncollabs[model]);
+            }
+        }
+    };
+    runWorkers(numThreads, worker);
+}
+
+/**
+ * Predicts both weighted lists for many actors with predictModels and no
+ * work limits
+ * Params:
+ * - graph: the graph of all actors
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads to use
+ * - collabs: filled with the top collaborators of each actor
+ * - uncollabs: filled with the top new collaborators of each actor
+ * Returns: void
+ */
+void predictFused(ActorGraph& graph, vector<string>& actors, int fromYear,
+                  int toYear, const vector<int>& nameRanks, int k,
+                  int numThreads, vector<vector<string>>& collabs,
+                  vector<vector<string>>& uncollabs) {
+    vector<vector<vector<string>>> modelCollabs;
+    vector<vector<vector<string>>> modelUncollabs;
+    vector<char> truncated;
+    predictModels(graph, actors, fromYear, toYear, nameRanks, k,
+                  {WEIGHTED_MODEL}, WorkLimits(), numThreads, modelCollabs,
+                  modelUncollabs, truncated);
+    collabs = move(modelCollabs[0]);
+    uncollabs = move(modelUncollabs[0]);
+}
+
+/**
+ * Predicts both weighted lists for many actors from an index built ahead of
+ * time, predicting only the actors it does not have with the fused
+ * LinkPredictor
+ * Params:
+ * - graph: the graph of all actors
+ * - index: the index, built for the same graph, years and k
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads to predict missing actors with
+ * - collabs: filled with the top collaborators of each actor
+ * - uncollabs: filled with the top new collaborators of each actor
+ * Returns: void
+ */
+void predictIndexed(ActorGraph& graph, TopKIndex& index,
+                    vector<string>& actors, int fromYear, int toYear,
+                    const vector<int>& nameRanks, int k, int numThreads,
+                    vector<vector<string>>& collabs,
+                    vector<vector<string>>& uncollabs) {
+    collabs.assign(actors.size(), {});
+    uncollabs.assign(actors.size(), {});
+    vector<string> missing;
+    vector<int> missingAt;  // Index in actors of each missing actor
+    vector<int> collabIds;
+    vector<int> uncollabIds;
+    for (int actor = 0; actor < (int)actors.size(); actor++) {
+        Node* node = graph.getActorNode(actors[actor]);
+        if (!node) {
             continue;
         }
-        collaborators[edges[edge]->getDest()]++;
-    }
-    vector<pair<string, int>> closest;
-
-    // Loops through each collaborator in order to calculate their priority
-    for (auto iter = collaborators.begin(); iter != collaborators.end();
-         iter++) {
-        vector<Edge*> neighbors = iter->first->getEdges();
-        unordered_map<Node*, int> neighborMap;
-        // sorts through all outgoing edges of neighbor node to find number of
-        // edges between each neighbor and current actor
-        for (int edge = 0; edge < neighbors.size(); edge++) {
-            if (collaborators.find(neighbors[edge]->getDest()) ==
-                    collaborators.end() ||
-                neighbors[edge]->getDest() == iter->first) {
-                // neighbor not a collaborator or itself
+        if (index.lookup(node->getId(), collabIds, uncollabIds)) {
+            collabs[actor] = getNames(graph, collabIds);
+            uncollabs[actor] = getNames(graph, uncollabIds);
+        } else {
+            missing.push_back(actors[actor]);
+            missingAt.push_back(actor);
+        }
+    }
+    if (missing.empty()) {
+        return;
+    }
+    vector<vector<string>> missingCollabs;
+    vector<vector<string>> missingUncollabs;
+    predictFused(graph, missing, fromYear, toYear, nameRanks, k, numThreads,
+                 missingCollabs, missingUncollabs);
+    for (int actor = 0; actor < (int)missing.size(); actor++) {
+        collabs[missingAt[actor]] = move(missingCollabs[actor]);
+        uncollabs[missingAt[actor]] = move(missingUncollabs[actor]);
+    }
+}
+
+/**
+ * Predicts both lists for many actors by intersecting sorted rows of the
+ * collaboration matrix, one thread per part of the actors. Every candidate's
+ * row is intersected with the actor's to find their shared collaborators.
+ * Params:
+ * - graph: the graph of all actors
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads to use
+ * - collabs: filled with the top collaborators of each actor
+ * - uncollabs: filled with the top new collaborators of each actor
+ * Returns: void
+ */
+void predictIntersect(ActorGraph& graph, vector<string>& actors, int fromYear,
+                      int toYear, const vector<int>& nameRanks, int k,
+                      int numThreads, vector<vector<string>>& collabs,
+                      vector<vector<string>>& uncollabs) {
+    CollabMatrix matrix(graph, fromYear, toYear);
+    collabs.assign(actors.size(), {});
+    uncollabs.assign(actors.size(), {});
+    atomic<int> nextActor(0);
+    auto worker = [&](int) {
+        vector<int> direct(matrix.getNumRows(), 0);
+        vector<bool> isCandidate(matrix.getNumRows(), false);
+        vector<int> candidates;
+        vector<int> matches;
+        TopKSelector oldTop(nameRanks, k);
+        TopKSelector newTop(nameRanks, k);
+        for (int actor = nextActor++; actor < (int)actors.size();
+             actor = nextActor++) {
+            Node* node = graph.getActorNode(actors[actor]);
+            if (!node) {
                 continue;
             }
-            if (neighborMap.find(neighbors[edge]->getDest()) ==
-                neighborMap.end()) {
-                // edge between collaborator and neighbor not in list
-                neighborMap[neighbors[edge]->getDest()] = 1;
+            int id = node->getId();
+            const int* columns = matrix.getColumns(id);
+            const int* values = matrix.getValues(id);
+            int length = matrix.getRowLength(id);
+            for (int entry = 0; entry < length; entry++) {
+                direct[columns[entry]] = values[entry];
+            }
+            // Actors two steps away who are not collaborators yet
+            for (int entry = 0; entry < length; entry++) {
+                const int* costars = matrix.getColumns(columns[entry]);
+                int numCostars = matrix.getRowLength(columns[entry]);
+                for (int costar = 0; costar < numCostars; costar++) {
+                    int candidate = costars[costar];
+                    if (candidate != id && direct[candidate] == 0 &&
+                        !isCandidate[candidate]) {
+                        isCandidate[candidate] = true;
+                        candidates.push_back(candidate);
+                    }
+                }
+            }
+            for (int entry = 0; entry < length; entry++) {
+                oldTop.offer(scoreByIntersection(matrix, id, columns[entry],
+                                                 direct, matches),
+                             columns[entry]);
+            }
+            for (int candidate : candidates) {
+                newTop.offer(scoreByIntersection(matrix, id, candidate, direct,
+                                                 matches),
+                             candidate);
+                isCandidate[candidate] = false;
+            }
+            for (int entry = 0; entry < length; entry++) {
+                direct[columns[entry]] = 0;
+            }
+            candidates.clear();
+            collabs[actor] = getNames(graph, oldTop.takeTop());
+            uncollabs[actor] = getNames(graph, newTop.takeTop());
+        }
+    };
+    runWorkers(numThreads, worker);
+}
 
+/**
+ * Predicts both lists for many actors, approximately for hubs: actors with at
+ * least hubDegree collaborators are predicted by an ApproximatePredictor,
+ * every other actor exactly with the fused LinkPredictor. Each thread keeps
+ * one predictor of each kind.
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix
+ * - index: the MinHash index of the matrix
+ * - actors: names of the actors to be predicted
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - hubDegree: the number of collaborators from which an actor is a hub
+ * - numThreads: the number of threads to use
+ * - collabs: filled with the top collaborators of each actor
+ * - uncollabs: filled with the top new collaborators of each actor
+ * Returns: void
+ */
+void predictApproximate(ActorGraph& graph, CollabMatrix& matrix,
+                        MinHashIndex& index, vector<string>& actors,
+                        const vector<int>& nameRanks, int k, int hubDegree,
+                        int numThreads, vector<vector<string>>& collabs,
+                        vector<vector<string>>& uncollabs) {
+    collabs.assign(actors.size(), {});
+    uncollabs.assign(actors.size(), {});
+    atomic<int> nextActor(0);
+    auto worker = [&](int) {
+        LinkPredictor exact(graph, matrix, nameRanks, k);
+        ApproximatePredictor approximate(graph, matrix, index, nameRanks, k);
+        for (int actor = nextActor++; actor < (int)actors.size();
+             actor = nextActor++) {
+            Node* node = graph.getActorNode(actors[actor]);
+            if (!node) {
+                continue;
+            }
+            int id = node->getId();
+            if (matrix.getRowLength(id) >= hubDegree) {
+                approximate.predict(id, collabs[actor], uncollabs[actor]);
             } else {
-                neighborMap[neighbors[edge]->getDest()]++;
+                exact.predict(id, collabs[actor], uncollabs[actor]);
             }
         }
-        int priority = 0;
-        // Goes through neighbors to calculate priority
-        for (auto iter2 = neighborMap.begin(); iter2 != neighborMap.end();
-             iter2++) {
-            // numEdges from actor to collab * numEdges from collab to current
-            priority += (collaborators[iter2->first] * iter2->second);
+    };
+    runWorkers(numThreads, worker);
+}
+
+/**
+ * Reports to standard error how the approximate mode does on the hubs among
+ * the actors: how long building the index takes, the time of an exact and of
+ * an approximate prediction with one thread, and the recall at k of both
+ * lists, the share of the exact list the approximate one also found
+ * Params:
+ * - graph: the graph of all actors
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - bands: the number of bands of the index
+ * - rows: the number of hashes in each band
+ * - hubDegree: the number of collaborators from which an actor is a hub
+ * Returns: void
+ */
+void reportApproximation(ActorGraph& graph, vector<string>& actors,
+                         int fromYear, int toYear, const vector<int>& nameRanks,
+                         int k, int bands, int rows, int hubDegree) {
+    CollabMatrix matrix(graph, fromYear, toYear);
+    vector<string> hubs;
+    for (string& name : actors) {
+        Node* node = graph.getActorNode(name);
+        if (node && matrix.getRowLength(node->getId()) >= hubDegree) {
+            hubs.push_back(name);
         }
-        pair<string, int> collaborator;
-        collaborator.first = iter->first->getName();  // Name of collaborator
-        collaborator.second = priority;  // priority of collaborator
-        closest.push_back(collaborator);
-    }
-    // Sort vector from largest to smallest priority
-    sort(closest.begin(), closest.end(), compare);
-    vector<string> top;
-    for (int rank = 0; rank < closest.size(); rank++) {
-        if (rank == TOP_RANK) {
-            break;  // 4 actors already in list
+    }
+    if (hubs.empty()) {
+        cerr << "lsh: no actor has " << hubDegree << " collaborators" << endl;
+        return;
+    }
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    MinHashIndex index(matrix, bands, rows, 1);
+    chrono::steady_clock::time_point built = chrono::steady_clock::now();
+    vector<vector<string>> exactCollabs(hubs.size());
+    vector<vector<string>> exactUncollabs(hubs.size());
+    LinkPredictor exact(graph, matrix, nameRanks, k);
+    for (int hub = 0; hub < (int)hubs.size(); hub++) {
+        exact.predict(graph.getActorNode(hubs[hub])->getId(),
+                      exactCollabs[hub], exactUncollabs[hub]);
+    }
+    chrono::steady_clock::time_point exacted = chrono::steady_clock::now();
+    vector<vector<string>> collabs;
+    vector<vector<string>> uncollabs;
+    predictApproximate(graph, matrix, index, hubs, nameRanks, k, hubDegree, 1,
+                       collabs, uncollabs);
+    chrono::steady_clock::time_point approximated = chrono::steady_clock::now();
+
+    double recall[2] = {0, 0};  // Of collaborators and of new actors
+    int numLists[2] = {0, 0};
+    for (int hub = 0; hub < (int)hubs.size(); hub++) {
+        vector<string>* wanted[2] = {&exactCollabs[hub], &exactUncollabs[hub]};
+        vector<string>* got[2] = {&collabs[hub], &uncollabs[hub]};
+        for (int list = 0; list < 2; list++) {
+            if (wanted[list]->empty()) {
+                continue;
+            }
+            int found = 0;
+            for (string& name : *got[list]) {
+                found += count(wanted[list]->begin(), wanted[list]->end(), name);
+            }
+            recall[list] += (double)found / wanted[list]->size();
+            numLists[list]++;
         }
-        top.push_back(closest[rank].first);
     }
-    return top;
+    double exactTime =
+        chrono::duration<double, micro>(exacted - built).count() / hubs.size();
+    double approximateTime =
+        chrono::duration<double, micro>(approximated - exacted).count() /
+        hubs.size();
+    cerr << "lsh bands: " << bands << " rows: " << rows
+         << " hubs: " << hubs.size() << " index seconds: "
+         << chrono::duration<double>(built - begin).count()
+         << " exact microseconds: " << exactTime
+         << " approximate microseconds: " << approximateTime << " speedup: "
+         << (approximateTime > 0 ? exactTime / approximateTime : 0)
+         << " collaborator recall@" << k << ": "
+         << (numLists[0] ? recall[0] / numLists[0] : 1) << " new recall@" << k
+         << ": " << (numLists[1] ? recall[1] / numLists[1] : 1) << endl;
 }
 
 /**
- * Compare function for two pair<string, int>, to rank priority values
- * Params: left, the left hand side pair
- *          right, the right hand side pair
- * Returns true if left has bigger priority or if same if right has bigger
- * alphabetical order
+ * Predicts both lists for every actor with one of the engines
+ * Params:
+ * - graph: the graph of all actors
+ * - engine: the name of the engine
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads the engine may use
+ * - collabs: filled with the top collaborators of each actor
+ * - uncollabs: filled with the top new collaborators of each actor
+ * Returns: void
  */
-bool compare(pair<string, int> left, pair<string, int> right) {
-    if (left.second != right.second) {
-        return left.second > right.second;
-    } else {
-        return left.first < right.first;
+void predictAll(ActorGraph& graph, string engine, vector<string>& actors,
+                int fromYear, int toYear, const vector<int>& nameRanks, int k,
+                int numThreads, vector<vector<string>>& collabs,
+                vector<vector<string>>& uncollabs) {
+    if (engine == SPGEMM_ENGINE) {
+        predictBatch(graph, actors, fromYear, toYear, nameRanks, k,
+                     numThreads, collabs, uncollabs);
+        return;
+    }
+    if (engine == SPA_ENGINE) {
+        predictFused(graph, actors, fromYear, toYear, nameRanks, k,
+                     numThreads, collabs, uncollabs);
+        return;
+    }
+    if (engine == INTERSECT_ENGINE) {
+        predictIntersect(graph, actors, fromYear, toYear, nameRanks, k,
+                         numThreads, collabs, uncollabs);
+        return;
+    }
+    collabs.clear();
+    uncollabs.clear();
+    for (int actor = 0; actor < (int)actors.size(); actor++) {
+        collabs.push_back(predictCollaborate(graph, actors[actor], fromYear,
+                                             toYear, nameRanks, k));
+        uncollabs.push_back(predictNew(graph, actors[actor], fromYear, toYear,
+                                       nameRanks, k));
     }
 }
 
 /**
- * Predicts the top four actors that are most likely to be in the next movie
- * with actor out of those who haven't collaborated with the actor
+ * Times every engine on the actors and reports each one's throughput to
+ * standard error
  * Params:
  * - graph: the graph of all actors
- * - actorName: name of actor to be predicted
- * Returns: top four actors in next movie (out of non-collaborators)
+ * - actors: names of the actors to be predicted
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads the engines may use
+ * Returns: void
  */
-vector<string> predictNew(ActorGraph& graph, string actorName) {
-    Node* actor = graph.getActorNode(actorName);
-    vector<Edge*> edges = actor->getEdges();
-    unordered_map<Node*, int> collaborators;
-    // Finds all collaborators and number of movies both are in
-    for (int edge = 0; edge < edges.size(); edge++) {
-        if (collaborators.find(edges[edge]->getDest()) == collaborators.end()) {
-            // collaborator not in map
-            collaborators.insert({edges[edge]->getDest(), 1});
-            continue;
+void reportBenchmark(ActorGraph& graph, vector<string>& actors, int fromYear,
+                     int toYear, const vector<int>& nameRanks, int k,
+                     int numThreads) {
+    for (const char* engine : ENGINES) {
+        vector<vector<string>> collabs;
+        vector<vector<string>> uncollabs;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        predictAll(graph, engine, actors, fromYear, toYear, nameRanks, k,
+                   numThreads, collabs, uncollabs);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() -
+                                                  begin)
+                             .count();
+        cerr << engine << " actors: " << actors.size()
+             << " seconds: " << seconds << " actors per second: "
+             << (seconds > 0 ? actors.size() / seconds : 0) << endl;
+    }
+
+    // Every model from one expansion per actor
+    vector<int> models;
+    for (int model = 0; model < NUM_MODELS; model++) {
+        models.push_back(model);
+    }
+    vector<vector<vector<string>>> collabs;
+    vector<vector<vector<string>>> uncollabs;
+    vector<char> truncated;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    predictModels(graph, actors, fromYear, toYear, nameRanks, k, models,
+                  WorkLimits(), numThreads, collabs, uncollabs, truncated);
+    double seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    cerr << SPA_ENGINE " all " << NUM_MODELS << " models actors: "
+         << actors.size() << " seconds: " << seconds
+         << " actors per second: "
+         << (seconds > 0 ? actors.size() / seconds : 0) << endl;
+}
+
+/**
+ * Reports to standard error how long one prediction takes for an actor with
+ * the fewest collaborators, one with the median number and the one with the
+ * most, with the fused predictor within the work limits and with the hash
+ * maps
+ * Params:
+ * - graph: the graph of all actors
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - nameRanks: the alphabetical rank of each actor's name, to break ties
+ * - k: the number of actors to predict in each list
+ * - limits: bounds on the work of each fused prediction
+ * Returns: void
+ */
+void reportLatency(ActorGraph& graph, int fromYear, int toYear,
+                   const vector<int>& nameRanks, int k, WorkLimits limits) {
+    CollabMatrix matrix(graph, fromYear, toYear);
+    vector<pair<int, int>> degrees;  // Collaborators and id of each actor
+    for (int actor = 0; actor < matrix.getNumRows(); actor++) {
+        if (matrix.getRowLength(actor) > 0) {
+            degrees.push_back({matrix.getRowLength(actor), actor});
         }
-        collaborators[edges[edge]->getDest()]++;
-    }
-    unordered_map<Node*, int>
-        noncollabs;  // one degree of separation apart from actor
-
-    // Loops through each collaborator to find all actors that are one degree
-    // apart
-    for (auto iter = collaborators.begin(); iter != collaborators.end();
-         iter++) {
-        vector<Edge*> neighbors = iter->first->getEdges();
-        // Loops through each edge to create list of non-collaborators
-        for (int edge = 0; edge < neighbors.size(); edge++) {
-            if (collaborators.find(neighbors[edge]->getDest()) ==
-                    collaborators.end() &&
-                neighbors[edge]->getDest() != actor) {
-                // if the edge from the collaborator is not another collaborator
-                // nor the original actor
-                if (noncollabs.find(neighbors[edge]->getDest()) ==
-                    noncollabs.end()) {
-                    // noncollaborator not in hashmap yet
-                    noncollabs[neighbors[edge]->getDest()] = 0;
-                }
+    }
+    if (degrees.empty()) {
+        return;
+    }
+    sort(degrees.begin(), degrees.end());
+    pair<string, pair<int, int>> samples[] = {
+        {"low", degrees.front()},
+        {"median", degrees[degrees.size() / 2]},
+        {"hub", degrees.back()}};
+
+    LinkPredictor predictor(graph, matrix, nameRanks, k, limits);
+    for (auto& sample : samples) {
+        int actor = sample.second.second;
+        string name = graph.getActorById(actor)->getName();
+        vector<string> collabs;
+        vector<string> uncollabs;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        for (int repeat = 0; repeat < LATENCY_REPEATS; repeat++) {
+            predictor.predict(actor, collabs, uncollabs);
+        }
+        chrono::steady_clock::time_point fused = chrono::steady_clock::now();
+        for (int repeat = 0; repeat < LATENCY_REPEATS; repeat++) {
+            predictCollaborate(graph, name, fromYear, toYear, nameRanks, k);
+            predictNew(graph, name, fromYear, toYear, nameRanks, k);
+        }
+        chrono::steady_clock::time_point hashed = chrono::steady_clock::now();
+        cerr << sample.first << " degree: " << sample.second.first
+             << " entries read: " << predictor.getLastWork()
+             << (predictor.wasTruncated() ? " " TRUNCATED_FLAG : "")
+             << " " SPA_ENGINE " microseconds: "
+             << chrono::duration<double, micro>(fused - begin).count() /
+                    LATENCY_REPEATS
+             << " " HASH_ENGINE " microseconds: "
+             << chrono::duration<double, micro>(hashed - fused).count() /
+                    LATENCY_REPEATS
+             << endl;
+    }
+}
+
+/**
+ * Adds batches of new cast rows to the graph, keeping both lists of every
+ * actor up to date with an IncrementalPredictor, and reports to standard
+ * error the time of each update. When benchmarking, every actor is also
+ * predicted again from scratch to report that time next to it and how many
+ * actors' lists the two disagree on.
+ * Params:
+ * - graph: the graph of all actors
+ * - fromYear: the earliest year of a movie to count
+ * - toYear: the latest year of a movie to count
+ * - k: the number of actors to predict in each list
+ * - numThreads: the number of threads to use
+ * - batches: the files of new rows, one per batch
+ * - benchmark: whether to compare each update with predicting again
+ * - incremental: the lists of every actor, updated after each batch
+ * Returns: false if a batch could not be read, otherwise true
+ */
+bool runUpdates(ActorGraph& graph, int fromYear, int toYear, int k,
+                int numThreads, vector<string>& batches, bool benchmark,
+                IncrementalPredictor& incremental) {
+    for (int batch = 0; batch < (int)batches.size(); batch++) {
+        vector<Edge*> newEdges;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        // Link prediction never asks for components
+        if (!graph.addFromFile(batches[batch].c_str(), newEdges, false)) {
+            return false;
+        }
+        chrono::steady_clock::time_point loaded = chrono::steady_clock::now();
+        int affected = incremental.addEdges(newEdges, numThreads);
+        chrono::steady_clock::time_point updated = chrono::steady_clock::now();
+
+        vector<int> movies;
+        for (Edge* edge : newEdges) {
+            movies.push_back(edge->getName().id);
+        }
+        sort(movies.begin(), movies.end());
+        int numMovies = unique(movies.begin(), movies.end()) - movies.begin();
+        double updateSeconds =
+            chrono::duration<double>(updated - loaded).count();
+        cerr << batches[batch] << " movies: " << numMovies
+             << " new pairs: " << newEdges.size()
+             << " affected actors: " << affected << " of "
+             << graph.getNumActors() << " load seconds: "
+             << chrono::duration<double>(loaded - begin).count()
+             << " update seconds: " << updateSeconds
+             << " update seconds per movie: "
+             << (numMovies ? updateSeconds / numMovies : 0);
+        if (benchmark) {
+            IncrementalPredictor recomputed(graph, fromYear, toYear, k,
+                                            numThreads);
+            chrono::steady_clock::time_point finished =
+                chrono::steady_clock::now();
+            int mismatched = 0;
+            for (int actor = 0; actor < graph.getNumActors(); actor++) {
+                mismatched += incremental.getCollabs(actor) !=
+                                  recomputed.getCollabs(actor) ||
+                              incremental.getUncollabs(actor) !=
+                                  recomputed.getUncollabs(actor);
             }
+            cerr << " recompute seconds: "
+                 << chrono::duration<double>(finished - updated).count()
+                 << " mismatched actors: " << mismatched;
         }
+        cerr << endl;
     }
+    return true;
+}
 
-    // Loops through each noncollaborator to calculate its priority
-    for (auto iter = noncollabs.begin(); iter != noncollabs.end(); iter++) {
-        vector<Edge*> neighbors = iter->first->getEdges();
-        unordered_map<Node*, int> priorities;
-        // Loops through each edge to find number of edges shared with a
-        // collaborator
-        for (int edge = 0; edge < neighbors.size(); edge++) {
-            if (collaborators.find(neighbors[edge]->getDest()) !=
-                collaborators.end()) {
-                // Edge is with a collaborator
-                if (priorities.find(neighbors[edge]->getDest()) ==
-                    priorities.end()) {
-                    // collaborator not in list
-                    priorities[neighbors[edge]->getDest()] = 1;
-                } else {
-                    priorities[neighbors[edge]->getDest()]++;
-                }
+/**
+ * Scores pairs of actors under several models, one thread per part of the
+ * pairs, each thread taking the next pair
+ * Params:
+ * - graph: the graph of all actors
+ * - matrix: the collaboration matrix
+ * - pairs: the names of the actors of each pair
+ * - models: the numbers of the scoring models
+ * - numThreads: the number of threads to use
+ * - scores: filled with the score of each pair under each model, or nothing
+ *   for pairs with an actor not in the graph
+ * Returns: void
+ */
+void scorePairs(ActorGraph& graph, CollabMatrix& matrix,
+                vector<pair<string, string>>& pairs, const vector<int>& models,
+                int numThreads, vector<vector<double>>& scores) {
+    scores.assign(pairs.size(), {});
+    atomic<int> nextPair(0);
+    auto worker = [&](int) {
+        vector<int> matches;
+        vector<int> otherMatches;
+        for (int query = nextPair++; query < (int)pairs.size();
+             query = nextPair++) {
+            Node* actor = graph.getActorNode(pairs[query].first);
+            Node* other = graph.getActorNode(pairs[query].second);
+            if (!actor || !other) {
+                continue;
+            }
+            for (int model : models) {
+                scores[query].push_back(scorePair(matrix, model,
+                                                  actor->getId(),
+                                                  other->getId(), matches,
+                                                  otherMatches));
             }
         }
-        // Calculates total priority of noncollaborator
-        int priority = 0;
-        for (auto iter2 = priorities.begin(); iter2 != priorities.end();
-             iter2++) {
-            // For each collab, find product between actor and collab and collab
-            // and curr
-            priority +=
-                (collaborators.find(iter2->first)->second * iter2->second);
+    };
+    runWorkers(numThreads, worker);
+}
+
+/**
+ * Parses a file of pairs of actors, like pathfinder's, to extract the pairs
+ * Params:
+ * - pairFile: name of file containing a header line, then two tab separated
+ *   actors per line
+ * Returns: a vector of the pairs of actors
+ */
+vector<pair<string, string>> parsePairs(string pairFile) {
+    ifstream infile(pairFile);
+    vector<pair<string, string>> pairs;
+    string line;
+    // skip the header
+    getline(infile, line);
+    while (getline(infile, line)) {
+        stringstream ss(line);
+        pair<string, string> actors;
+        getline(ss, actors.first, ACTOR_DELIM);
+        getline(ss, actors.second, ACTOR_DELIM);
+        if (actors.first != "") {
+            pairs.push_back(actors);
         }
-        iter->second = priority;
     }
+    return pairs;
+}
 
-    vector<pair<string, int>> allNoncollabs;
-    for (auto iter = noncollabs.begin(); iter != noncollabs.end(); iter++) {
-        pair<string, int> noncollab;
-        noncollab.first = iter->first->getName();
-        noncollab.second = iter->second;
-        allNoncollabs.push_back(noncollab);
+/**
+ * Writes the scores of pairs of actors to a file, one line per pair: both
+ * actors and then their score under each model, or MISSING_SCORE under each
+ * model if the pair has no scores
+ * Params:
+ * - filename: the name of the file
+ * - pairs: the names of the actors of each pair
+ * - modelNames: the names of the models, as the header of their columns
+ * - scores: the score of each pair under each model, or nothing
+ * Returns: the number of pairs without scores
+ */
+int writeScores(string filename, vector<pair<string, string>>& pairs,
+                vector<string>& modelNames, vector<vector<double>>& scores) {
+    ofstream output(filename);
+    output << HEADER_COLUMN "1" << ACTOR_DELIM << HEADER_COLUMN "2";
+    for (string& name : modelNames) {
+        output << ACTOR_DELIM << name;
     }
-
-    std::sort(allNoncollabs.begin(), allNoncollabs.end(), compare);
-
-    vector<string> top;
-    for (int rank = 0; rank < allNoncollabs.size(); rank++) {
-        if (rank == TOP_RANK) {
-            break;  // 4 actors already added
+    output << endl;
+    int numMissing = 0;
+    for (int query = 0; query < (int)pairs.size(); query++) {
+        output << pairs[query].first << ACTOR_DELIM << pairs[query].second;
+        if (scores[query].empty()) {
+            // Every row keeps a column per model
+            for (int model = 0; model < (int)modelNames.size(); model++) {
+                output << ACTOR_DELIM << MISSING_SCORE;
+            }
+            numMissing++;
+        }
+        for (double score : scores[query]) {
+            output << ACTOR_DELIM << score;
         }
-        top.push_back(allNoncollabs[rank].first);
+        output << endl;
     }
-    return top;
+    return numMissing;
 }
 
 /**
@@ -241,6 +831,40 @@ vector<string> parseFile(string actorFile) {
     return actors;
 }
 
+/**
+ * Writes the predicted lists of every actor to a file, one line per actor
+ * Params:
+ * - filename: the name of the file
+ * - k: the number of actors predicted in each list
+ * - lists: the predicted actors of each actor
+ * - truncated: whether each actor's prediction hit a work limit, flagged at
+ *   the end of its line
+ * Returns: void
+ */
+void writePredictions(string filename, int k, vector<vector<string>>& lists,
+                      const vector<char>& truncated) {
+    ofstream output;
+    output.open(filename);
+    string header;
+    for (int column = 1; column <= k; column++) {
+        header += (column > 1 ? string(1, HEADER_DELIM) : "") +
+                  HEADER_COLUMN + to_string(column);
+    }
+    output << header << endl;
+    for (int actor = 0; actor < (int)lists.size(); actor++) {
+        vector<string>& list = lists[actor];
+        for (int rank = 0; rank < (int)list.size(); rank++) {
+            output << list[rank];
+            output << ACTOR_DELIM;  // prints tab
+        }
+        if (actor < (int)truncated.size() && truncated[actor]) {
+            output << TRUNCATED_FLAG;
+        }
+        output << endl;
+    }
+    output.close();
+}
+
 /**
  * Runs link predictor to find the which actors most likely to be in next
  * movie
@@ -250,38 +874,261 @@ vector<string> parseFile(string actorFile) {
  *          containing movie vasts, name of file containing actors algorithm
  *          is to be run on, output file name of actors current actor
  *          collaborated with, and output file name of actors who current actor
- *          haven't collaborated with pairs Returns: 0 if success, otherwise 1
+ *          haven't collaborated with pairs. Optionally --from-year and
+ *          --to-year only count movies from a range of years, --engine
+ *          picks how candidates are scored, --threads how many threads
+ *          score them, --top-k how many actors are predicted, --model
+ *          which scoring models to use and --benchmark times every engine
+ *          and the latency of single actors. --lsh predicts hubs, actors
+ *          with at least --lsh-hub-degree collaborators, from a sample of
+ *          their neighborhood and a MinHash index with --lsh-bands bands of
+ *          --lsh-rows hashes; --benchmark then also reports its speedup and
+ *          recall.
+ *          --hub-cap skips or samples, by --hub-policy, collaborators with
+ *          more costars than it and --work-budget bounds the matrix entries
+ *          read per actor; lines of actors that hit either end with
+ *          #TRUNCATED. --index answers from a file written by linkindex
+ *          and predicts only the actors it does not have. --update adds
+ *          files of new cast rows one at a time, predicting again only the
+ *          actors they affect, and reports each update's cost, next to
+ *          predicting every actor again with --benchmark. --score-pairs
+ *          instead reads a file of pairs like pathfinder's in place of the
+ *          actors and writes the score of each pair under each model to the
+ *          file after it, or nan for pairs with an actor not in the graph.
+ *          With several models, each model's lists go to the
+ *          output names followed by '.' and the model's name.
+ *          Returns: 0 if success, otherwise 1
  */
 int main(int argc, char* argv[]) {
+    cxxopts::Options options(argv[0], "Predicts future collaborators");
+    options.add_options()(
+        "from-year", "Only count movies from this year or later",
+        cxxopts::value<int>()->default_value(to_string(MIN_YEAR)))(
+        "to-year", "Only count movies from this year or earlier",
+        cxxopts::value<int>()->default_value(to_string(MAX_YEAR)))(
+        "engine",
+        "How to score candidates: " HASH_ENGINE ", " SPGEMM_ENGINE
+        ", " SPA_ENGINE " or " INTERSECT_ENGINE,
+        cxxopts::value<string>()->default_value(SPA_ENGINE))(
+        "threads", "Number of threads to use",
+        cxxopts::value<int>()->default_value(
+            to_string(max(1, (int)thread::hardware_concurrency()))))(
+        "benchmark",
+        "Report the throughput of every engine and the latency of low, "
+        "median and hub degree actors")(
+        "top-k", "Number of actors to predict for each actor",
+        cxxopts::value<int>()->default_value(to_string(TOP_RANK)))(
+        "model",
+        "Scoring models, comma separated: weighted, cn, jaccard, "
+        "adamic-adar, ra, pa or katz",
+        cxxopts::value<vector<string>>()->default_value(
+            MODEL_NAMES[WEIGHTED_MODEL]))(
+        "lsh", "Predict hubs from a sample of their neighborhood")(
+        "lsh-bands", "Bands of the MinHash index, more find more actors",
+        cxxopts::value<int>()->default_value(to_string(LSH_BANDS)))(
+        "lsh-rows", "Hashes in each band, more find fewer actors",
+        cxxopts::value<int>()->default_value(to_string(LSH_ROWS)))(
+        "lsh-hub-degree", "Collaborators from which an actor is a hub",
+        cxxopts::value<int>()->default_value(to_string(HUB_DEGREE)))(
+        "hub-cap",
+        "Costars from which a collaborator is not fully expanded, 0 for none",
+        cxxopts::value<int>()->default_value("0"))(
+        "hub-policy",
+        "What to do with capped collaborators: " SKIP_POLICY " or "
+        SAMPLE_POLICY,
+        cxxopts::value<string>()->default_value(SKIP_POLICY))(
+        "work-budget", "Matrix entries read per actor, 0 for no bound",
+        cxxopts::value<long>()->default_value("0"))(
+        "index", "Answer from an index written by linkindex",
+        cxxopts::value<string>())(
+        "update",
+        "Files of new cast rows, each added as a batch and only the actors "
+        "it affects predicted again",
+        cxxopts::value<vector<string>>())(
+        "score-pairs",
+        "Score the pairs of a file like pathfinder's instead, writing them "
+        "to the file after it");
+    unique_ptr<cxxopts::ParseResult> parsed = parseOptions(options, argc, argv);
+    if (!parsed) {
+        return EXIT_FAILURE;
+    }
+    cxxopts::ParseResult& args = *parsed;
+    int fromYear = args["from-year"].as<int>();
+    int toYear = args["to-year"].as<int>();
+    string engine = args["engine"].as<string>();
+    int numThreads = max(1, args["threads"].as<int>());
+    int k = args["top-k"].as<int>();
+    if (k < 1) {
+        cerr << "--top-k must be at least 1" << endl << options.help() << endl;
+        return EXIT_FAILURE;
+    }
+    if (find(begin(ENGINES), end(ENGINES), engine) == end(ENGINES)) {
+        cerr << "Unknown engine " << engine << endl;
+        return EXIT_FAILURE;
+    }
+    vector<string> modelNames = args["model"].as<vector<string>>();
+    vector<int> models;
+    for (string& name : modelNames) {
+        models.push_back(findModel(name));
+        if (models.back() < 0) {
+            cerr << "Unknown model " << name << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (models != vector<int>{WEIGHTED_MODEL} && engine != SPA_ENGINE) {
+        cerr << "Only the " SPA_ENGINE " engine scores other models" << endl;
+        return EXIT_FAILURE;
+    }
+    bool approximate = args.count("lsh");
+    int bands = max(1, args["lsh-bands"].as<int>());
+    int rows = max(1, args["lsh-rows"].as<int>());
+    int hubDegree = max(1, args["lsh-hub-degree"].as<int>());
+    if (approximate && models != vector<int>{WEIGHTED_MODEL}) {
+        cerr << "--lsh only scores the weighted model" << endl;
+        return EXIT_FAILURE;
+    }
+    WorkLimits limits;
+    limits.hubCap = max(0, args["hub-cap"].as<int>());
+    limits.budget = max(0L, args["work-budget"].as<long>());
+    string policy = args["hub-policy"].as<string>();
+    if (policy != SKIP_POLICY && policy != SAMPLE_POLICY) {
+        cerr << "Unknown hub policy " << policy << endl;
+        return EXIT_FAILURE;
+    }
+    limits.policy = policy == SAMPLE_POLICY ? CAP_SAMPLE : CAP_SKIP;
+    if ((limits.hubCap || limits.budget) &&
+        (engine != SPA_ENGINE || approximate)) {
+        cerr << "Only the " SPA_ENGINE " engine bounds its work" << endl;
+        return EXIT_FAILURE;
+    }
+    bool indexed = args.count("index");
+    bool updating = args.count("update");
+    if ((indexed || updating) &&
+        (models != vector<int>{WEIGHTED_MODEL} || approximate ||
+         limits.hubCap || limits.budget)) {
+        cerr << "--index and --update only answer the exact weighted model"
+             << endl;
+        return EXIT_FAILURE;
+    }
+    bool scoring = args.count("score-pairs");
+    if (scoring && (approximate || limits.hubCap || limits.budget || indexed ||
+                    updating)) {
+        cerr << "--score-pairs scores exactly, without --lsh, limits, "
+                "--index or --update"
+             << endl;
+        return EXIT_FAILURE;
+    }
+    if (indexed && updating) {
+        cerr << "An index is not updated, use one of --index and --update"
+             << endl;
+        return EXIT_FAILURE;
+    }
+
     ActorGraph graph;
     graph.loadFromFile(argv[MOVIE_FILE], false);
+    if (scoring) {
+        vector<pair<string, string>> pairs = parsePairs(argv[PAIR_FILE]);
+        vector<vector<double>> scores;
+        CollabMatrix matrix(graph, fromYear, toYear);
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        scorePairs(graph, matrix, pairs, models, numThreads, scores);
+        double seconds = chrono::duration<double>(
+                             chrono::steady_clock::now() - begin)
+                             .count();
+        if (args.count("benchmark")) {
+            cerr << "pairs: " << pairs.size() << " seconds: " << seconds
+                 << " pairs per second: "
+                 << (seconds > 0 ? pairs.size() / seconds : 0) << endl;
+        }
+        int numMissing =
+            writeScores(argv[SCORE_FILE], pairs, modelNames, scores);
+        if (numMissing > 0) {
+            cerr << numMissing << " pairs have an actor not in the graph and "
+                 << "were scored " MISSING_SCORE << endl;
+        }
+        graph.clear();
+        return EXIT_SUCCESS;
+    }
     vector<string> actors = parseFile(argv[ACTOR_FILE]);
-
-    // Outputs to file
-    ofstream outputCollab;
-    ofstream outputUncollab;
-    outputCollab.open(argv[COLLAB_FILE]);
-    outputUncollab.open(argv[UNCOLLAB_FILE]);
-    outputCollab << HEADER1 << endl;
-    outputUncollab << HEADER2 << endl;
-    for (int actor = 0; actor < actors.size(); actor++) {
-        vector<string> collabs = predictCollaborate(graph, actors[actor]);
-        vector<string> uncollabs = predictNew(graph, actors[actor]);
-        // Outputs collaborators
-        for (int collab = 0; collab < collabs.size(); collab++) {
-            outputCollab << collabs[collab];
-            outputCollab << ACTOR_DELIM;  // prints tab
+    vector<int> nameRanks = graph.getNameRanks();
+    vector<vector<vector<string>>> allCollabs;
+    vector<vector<vector<string>>> allUncollabs;
+    vector<char> truncated;
+    TopKIndex index;
+    if (indexed && !index.open(args["index"].as<string>().c_str())) {
+        cerr << "Could not open index " << args["index"].as<string>()
+             << ", predicting live" << endl;
+        indexed = false;
+    } else if (indexed) {
+        // One pass over the edges, far less than predicting any actor
+        CollabMatrix matrix(graph, fromYear, toYear);
+        if (!index.matches(graph, matrix, k, fromYear, toYear)) {
+            cerr << "Index " << args["index"].as<string>()
+                 << " is not of this graph, years and k, predicting live"
+                 << endl;
+            indexed = false;
         }
-        outputCollab << endl;
-        // Outputs new collaborators
-        for (int uncollab = 0; uncollab < uncollabs.size(); uncollab++) {
-            outputUncollab << uncollabs[uncollab];
-            outputUncollab << ACTOR_DELIM;  // prints tab
+    }
+    if (updating) {
+        allCollabs.assign(1, vector<vector<string>>(actors.size()));
+        allUncollabs.assign(1, vector<vector<string>>(actors.size()));
+        IncrementalPredictor incremental(graph, fromYear, toYear, k,
+                                         numThreads);
+        vector<string> batches = args["update"].as<vector<string>>();
+        if (!runUpdates(graph, fromYear, toYear, k, numThreads, batches,
+                        args.count("benchmark"), incremental)) {
+            return EXIT_FAILURE;
+        }
+        // Actors first seen in a batch are predicted too
+        for (int actor = 0; actor < (int)actors.size(); actor++) {
+            Node* node = graph.getActorNode(actors[actor]);
+            if (node) {
+                allCollabs[0][actor] =
+                    getNames(graph, incremental.getCollabs(node->getId()));
+                allUncollabs[0][actor] =
+                    getNames(graph, incremental.getUncollabs(node->getId()));
+            }
+        }
+    } else if (indexed) {
+        allCollabs.resize(1);
+        allUncollabs.resize(1);
+        predictIndexed(graph, index, actors, fromYear, toYear, nameRanks, k,
+                       numThreads, allCollabs[0], allUncollabs[0]);
+    } else if (approximate) {
+        allCollabs.resize(1);
+        allUncollabs.resize(1);
+        CollabMatrix matrix(graph, fromYear, toYear);
+        MinHashIndex index(matrix, bands, rows, numThreads);
+        predictApproximate(graph, matrix, index, actors, nameRanks, k,
+                           hubDegree, numThreads, allCollabs[0],
+                           allUncollabs[0]);
+    } else if (engine == SPA_ENGINE) {
+        predictModels(graph, actors, fromYear, toYear, nameRanks, k, models,
+                      limits, numThreads, allCollabs, allUncollabs, truncated);
+    } else {
+        allCollabs.resize(1);
+        allUncollabs.resize(1);
+        predictAll(graph, engine, actors, fromYear, toYear, nameRanks, k,
+                   numThreads, allCollabs[0], allUncollabs[0]);
+    }
+    if (args.count("benchmark")) {
+        reportBenchmark(graph, actors, fromYear, toYear, nameRanks, k,
+                        numThreads);
+        reportLatency(graph, fromYear, toYear, nameRanks, k, limits);
+        if (approximate) {
+            reportApproximation(graph, actors, fromYear, toYear, nameRanks, k,
+                                bands, rows, hubDegree);
         }
-        outputUncollab << endl;
+    }
+
+    // Outputs to file
+    for (int model = 0; model < (int)models.size(); model++) {
+        string suffix = models.size() > 1 ? "." + modelNames[model] : "";
+        writePredictions(argv[COLLAB_FILE] + suffix, k, allCollabs[model],
+                         truncated);
+        writePredictions(argv[UNCOLLAB_FILE] + suffix, k, allUncollabs[model],
+                         truncated);
     }
     graph.clear();
-    outputCollab.close();
-    outputUncollab.close();
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -8,14 +8,28 @@
  */
 
 #include <algorithm>
+#include <cstdint>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <sstream>
 #include <unordered_map>
-#include <unordered_set>
+
+#include <thread>
 
 #include "ActorGraph.hpp"
+#include "Boruvka.hpp"
+#include "BufferedWriter.hpp"
+#include "DisjointSet.hpp"
+#include "EdgeSort.hpp"
+#include "ExternalMST.hpp"
+#include "FilterKruskal.hpp"
+#include "IncrementalMST.hpp"
+#include "Options.hpp"
+#include "Prim.hpp"
+#include "cxxopts.hpp"
 
 using namespace std;
 
@@ -37,17 +51,42 @@ using namespace std;
 #define SECONDLINE "#EDGE CHOSEN: "
 #define THIRDLINE "TOTAL EDGE WEIGHTS: "
 
+// Per component totals of a spanning forest
+#define COMPONENTLINE "#COMPONENT "
+#define NODES " NODES: "
+#define EDGES " EDGES: "
+#define WEIGHTS " WEIGHTS: "
+
 // Random actor to find first node to add all edges
 #define ACTOR "Kevin Bacon"
 
+// Ways of ordering the edges for Kruskal's algorithm
+#define HEAP_ENGINE "heap"    // Priority queue of both directions of each edge
+#define SORTED_ENGINE "sorted"  // Comparison sort of each undirected edge once
+#define RADIX_ENGINE "radix"  // Counting sort of each undirected edge once
+#define FILTER_ENGINE "filter"    // Filter-Kruskal, sorting only useful edges
+#define BORUVKA_ENGINE "boruvka"  // Parallel Boruvka instead of Kruskal
+#define PRIM_ENGINE "prim"        // Prim with a bucket queue instead of Kruskal
+#define EXTERNAL_ENGINE "external"  // Kruskal over sorted runs on disk
+
+// Bytes in a megabyte, the unit of the memory budget
+#define MEGABYTE (1 << 20)
+
+// Every engine, in the order they are benchmarked
+const char* const ENGINES[] = {HEAP_ENGINE,    SORTED_ENGINE, RADIX_ENGINE,
+                               FILTER_ENGINE,  BORUVKA_ENGINE, PRIM_ENGINE,
+                               EXTERNAL_ENGINE};
+
 /**
  * This method finds all edges in a particular graph
  * Params:
  *  - graph: a refeence of the graph containing all actor nodes
- * Returns: a priority queue ranking all edges in terms of edge weights
+ *  - bothDirections: if true, both directed edges of each pair of actors are
+ *                    found, otherwise only the one from the lower actor id
+ * Returns: a vector of the edges
  */
-priority_queue<Edge*, vector<Edge*>, EdgeComp> findEdges(ActorGraph& graph) {
-    priority_queue<Edge*, vector<Edge*>, EdgeComp> edges;
+vector<Edge*> findEdges(ActorGraph& graph, bool bothDirections) {
+    vector<Edge*> edges;
 
     queue<Node*> nodes;
     Node* start = graph.getActorNode(ACTOR);
@@ -63,7 +102,10 @@ priority_queue<Edge*, vector<Edge*>, EdgeComp> findEdges(ActorGraph& graph) {
         vector<Edge*> neighbors = current->getEdges();
         for (int edge = 0; edge < neighbors.size(); edge++) {
             // for each neighboring edge, add edges to edgeList
-            edges.push(neighbors[edge]);
+            if (bothDirections || current->getId() <
+                                      neighbors[edge]->getDest()->getId()) {
+                edges.push_back(neighbors[edge]);
+            }
             if (finished.find(neighbors[edge]->getDest()) == finished.end()) {
                 // Node not in list
                 nodes.push(neighbors[edge]->getDest());
@@ -74,155 +116,347 @@ priority_queue<Edge*, vector<Edge*>, EdgeComp> findEdges(ActorGraph& graph) {
     return edges;
 }
 
+/**
+ * This method finds all edges in every component of a graph by reading each
+ * actor's edge array in id order, without a traversal
+ * Params:
+ *  - graph: a reference of the graph containing all actor nodes
+ *  - bothDirections: if true, both directed edges of each pair of actors are
+ *                    found, otherwise only the one from the lower actor id
+ * Returns: a vector of the edges
+ */
+vector<Edge*> findAllEdges(ActorGraph& graph, bool bothDirections) {
+    vector<Edge*> edges;
+    for (int id = 0; id < graph.getNumActors(); id++) {
+        Node* actor = graph.getActorById(id);
+        pair<EdgeIter, EdgeIter> range =
+            actor->getEdgesInYears(MIN_YEAR, MAX_YEAR);
+        for (EdgeIter edge = range.first; edge != range.second; edge++) {
+            if (bothDirections || id < (*edge)->getDest()->getId()) {
+                edges.push_back(*edge);
+            }
+        }
+    }
+    return edges;
+}
+
 /**
  * This method finds the shortest path given a list of edges that comprise the
- * graph
+ * graph, with Kruskal's algorithm: edges are taken from lightest to heaviest
+ * and kept if they join two different uptrees
  * Params:
  *  - edges: the priority queue of edges, ranked by which higher priority is
  *          lower weight
- * Returns: A vector of edges representing the MST
+ *  - numActors: the number of actors in the graph
+ *  - sink: if set, receives each edge as it is chosen instead of the edges
+ *          being returned
+ * Returns: A vector of edges representing the MST, or nothing if sink is set
  */
 vector<Edge*> findShortestPath(
-    priority_queue<Edge*, vector<Edge*>, EdgeComp>& edges) {
-    unordered_map<Node*, unordered_set<Node*>> uptrees;
+    priority_queue<Edge*, vector<Edge*>, EdgeComp>& edges, int numActors,
+    EdgeSink sink = nullptr) {
+    DisjointSet uptrees(numActors);
     vector<Edge*> thePath;
 
     while (!edges.empty()) {
-        Edge* edge1 = edges.top();
-
+        Edge* edge = edges.top();
         edges.pop();
-        Edge* edge2 = nullptr;
-        if (!edges.empty()) {
-            edge2 = edges.top();
-            if (edge2->getName() == edge1->getName() &&
-                edge2->getDest() == edge1->getSource()) {
-                // Also pops from pq the equivalent edge pointing in opposite
-                // direction
-                edges.pop();
+        if (uptrees.unite(edge->getSource()->getId(),
+                          edge->getDest()->getId())) {
+            // Edge joins two uptrees, so it is in the MST. The edge pointing
+            // in the opposite direction is then skipped as a cycle.
+            if (sink) {
+                sink(edge);
             } else {
-                edge2 = nullptr;
+                thePath.push_back(edge);
             }
         }
+    }
+    return thePath;
+}
 
-        Node* source = edge1->getSource();
-        Node* dest = edge1->getDest();
-        if (source->getSentinel() != nullptr &&
-            dest->getSentinel() != nullptr) {
-            // Both Nodes are in uptrees
-            if (source->getSentinel() == dest->getSentinel()) {
-                // In same uptree
-                continue;
+/**
+ * This method finds the shortest path with Kruskal's algorithm given the
+ * edges of the graph already sorted by weight
+ * Params:
+ *  - edges: the undirected edges, from lowest to highest weight
+ *  - numActors: the number of actors in the graph
+ *  - sink: if set, receives each edge as it is chosen instead of the edges
+ *          being returned
+ * Returns: A vector of edges representing the MST, or nothing if sink is set
+ */
+vector<Edge*> findShortestPath(vector<Edge*>& edges, int numActors,
+                               EdgeSink sink = nullptr) {
+    DisjointSet uptrees(numActors);
+    vector<Edge*> thePath;
+    for (long edge = 0; edge < (long)edges.size(); edge++) {
+        if (uptrees.unite(edges[edge]->getSource()->getId(),
+                          edges[edge]->getDest()->getId())) {
+            if (sink) {
+                sink(edges[edge]);
             } else {
-                // In different uptrees
-
-                unordered_set<Node*> uptreeSource =
-                    uptrees[source->getSentinel()];
-                unordered_set<Node*> uptreeDest =
-                    uptrees[source->getSentinel()];
-                if (uptreeSource.size() > uptreeDest.size()) {
-                    // source's uptree is bigger
-                    thePath.push_back(edge1);
-                    dest->setPrev(edge1);
-                    uptrees.erase(dest->getSentinel());
-                    // Makes source's sentinel have a pointer to base of dest's
-                    // uptree
-                    source->getSentinel()->setBase(
-                        dest->getSentinel()->getBase());
-                    for (auto iter = uptreeDest.begin();
-                         iter != uptreeDest.end(); iter++) {
-                        Node* current = *iter;
-                        uptreeSource.insert(current);
-                        current->setSentinel(source->getSentinel());
-                    }
-                    uptrees[source->getSentinel()] = uptreeSource;
+                thePath.push_back(edges[edge]);
+            }
+            if (uptrees.getNumSets() == 1) {
+                // Every actor is already connected
+                break;
+            }
+        }
+    }
+    return thePath;
+}
 
+/**
+ * Finds the minimum spanning tree of the starting actor's component, or the
+ * minimum spanning forest of the whole graph, with one of the engines
+ * Params:
+ *  - graph: the graph of all actors
+ *  - engine: the name of the engine
+ *  - numThreads: the number of threads the engine may use
+ *  - memoryBudget: the most bytes of edges the external engine may hold
+ *  - forest: if true, spans every component instead of only the starting
+ *            actor's
+ *  - shortest: filled with the edges of the MST
+ *  - workBytes: set to the approximate peak bytes of the engine's working
+ *               arrays, not counting the graph itself
+ *  - sink: if set, receives each edge of the MST instead of shortest, as
+ *          soon as the engine chooses it
+ * Returns: false if the engine is unknown or failed, otherwise true
+ */
+bool findTree(ActorGraph& graph, string engine, int numThreads,
+              size_t memoryBudget, bool forest, vector<Edge*>& shortest,
+              size_t& workBytes, EdgeSink sink = nullptr) {
+    vector<Edge*> (*edgeFinder)(ActorGraph&, bool) =
+        forest ? findAllEdges : findEdges;
+    size_t uptreeBytes = graph.getNumActors() * 2 * sizeof(int);
+    if (engine == HEAP_ENGINE) {
+        vector<Edge*> allEdges = edgeFinder(graph, true);
+        priority_queue<Edge*, vector<Edge*>, EdgeComp> edges(EdgeComp(),
+                                                             allEdges);
+        // The edges, their copy in the heap, and the uptrees
+        workBytes = 2 * allEdges.size() * sizeof(Edge*) + uptreeBytes;
+        shortest = findShortestPath(edges, graph.getNumActors(), sink);
+    } else if (engine == SORTED_ENGINE) {
+        vector<Edge*> edges = edgeFinder(graph, false);
+        workBytes = edges.size() * sizeof(Edge*) + uptreeBytes;
+        sort(edges.begin(), edges.end(), [](Edge* lhs, Edge* rhs) {
+            return lhs->getWeight() < rhs->getWeight();
+        });
+        shortest = findShortestPath(edges, graph.getNumActors(), sink);
+    } else if (engine == RADIX_ENGINE) {
+        vector<Edge*> edges = edgeFinder(graph, false);
+        // The edges, the buffer they are scattered into, and the uptrees
+        workBytes = 2 * edges.size() * sizeof(Edge*) + uptreeBytes;
+        sortEdgesByWeight(edges, numThreads);
+        shortest = findShortestPath(edges, graph.getNumActors(), sink);
+    } else if (engine == FILTER_ENGINE) {
+        vector<Edge*> edges = edgeFinder(graph, false);
+        workBytes = edges.size() * sizeof(Edge*) + uptreeBytes;
+        shortest = findFilterKruskalForest(edges, graph.getNumActors(), sink);
+    } else if (engine == BORUVKA_ENGINE) {
+        vector<Edge*> edges = edgeFinder(graph, false);
+        // The edges, two lists of live edge indices, and a lightest edge and
+        // parent per actor
+        workBytes = edges.size() * (sizeof(Edge*) + 2 * sizeof(long)) +
+                    graph.getNumActors() * (sizeof(uint64_t) + sizeof(int));
+        shortest = findBoruvkaForest(edges, graph.getNumActors(), numThreads);
+    } else if (engine == PRIM_ENGINE) {
+        shortest =
+            findPrimForest(graph, forest ? nullptr : graph.getActorNode(ACTOR),
+                           &workBytes, sink);
+    } else if (engine == EXTERNAL_ENGINE) {
+        int component =
+            forest ? -1 : graph.getComponent(graph.getActorNode(ACTOR));
+        shortest.clear();
+        bool found = true;  // Whether every chosen record had its Edge
+        bool written = findExternalForest(
+            graph, component, memoryBudget,
+            [&](const EdgeRecord& record) {
+                Edge* edge = findRecordEdge(graph, record);
+                if (!edge) {
+                    found = false;
+                } else if (sink) {
+                    sink(edge);
                 } else {
-                    // source's uptree is smaller
-                    thePath.push_back(edge1);
-                    dest->setPrev(edge1);
-                    // Make dest's sentinel have a pointer to base of source's
-                    // uptree
-                    uptrees.erase(source->getSentinel());
-                    for (auto iter = uptreeSource.begin();
-                         iter != uptreeSource.end(); iter++) {
-                        Node* current = *iter;
-                        uptreeDest.insert(current);
-                        current->setSentinel(dest->getSentinel());
-                    }
-                    uptrees[dest->getSentinel()] = uptreeDest;
+                    shortest.push_back(edge);
                 }
-                continue;
-            }
+            },
+            &workBytes);
+        if (!written || !found) {
+            return false;
         }
-        if (source->getSentinel() != nullptr) {
-            // source is in an uptree but dest is not
-            unordered_set<Node*> uptree = uptrees[source->getSentinel()];
-            uptree.insert(dest);
-            thePath.push_back(edge1);
-            uptrees[source->getSentinel()] = uptree;
-            dest->setSentinel(source->getSentinel());
-            if (source != source->getSentinel()->getBase()) {
-                // Not a base
-                if (edge2 == nullptr) {
-                    // edge2 not the reverse of edge1
-                    edge2 = dest->findEdge(source->getName());
-                    if (dest == nullptr) {
-                        continue;
-                    }
-                }
-                dest->setPrev(edge2);
-                source->getSentinel()->setBase(dest);
-
-            } else {
-                dest->setPrev(edge1);
-                source->getSentinel()->setBase(dest);
-            }
+    } else {
+        return false;
+    }
+    if (sink) {
+        // Engines that only know the tree at the end
+        for (int edge = 0; edge < (int)shortest.size(); edge++) {
+            sink(shortest[edge]);
+        }
+        shortest.clear();
+    }
+    return true;
+}
 
-            continue;
+/**
+ * Times an engine with 1, 2, 4, ... up to maxThreads threads and reports the
+ * time and speedup over one thread of each to standard error
+ * Params:
+ *  - graph: the graph of all actors
+ *  - engine: the name of the engine
+ *  - maxThreads: the largest number of threads to try
+ *  - memoryBudget: the most bytes of edges the external engine may hold
+ *  - forest: if true, spans every component
+ * Returns: void
+ */
+void reportScaling(ActorGraph& graph, string engine, int maxThreads,
+                   size_t memoryBudget, bool forest) {
+    double single = 0;
+    for (int threads = 1; threads <= maxThreads;
+         threads = (threads == maxThreads) ? threads + 1
+                                           : min(maxThreads, threads * 2)) {
+        vector<Edge*> shortest;
+        size_t workBytes;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        if (!findTree(graph, engine, threads, memoryBudget, forest, shortest,
+                      workBytes)) {
+            cerr << engine << " failed" << endl;
+            return;
         }
-        if (dest->getSentinel() != nullptr) {
-            // dest is in an uptree but source is not
-
-            source->setSentinel(dest->getSentinel());
-            dest->setPrev(edge1);
-            thePath.push_back(edge1);
-            unordered_set<Node*> uptree = uptrees[dest->getSentinel()];
-            uptree.insert(source);
-            if (dest != dest->getSentinel()->getBase()) {
-                // Not a base
-                if (edge2 == nullptr) {
-                    // edge2 not the reverse of edge1
-                    edge2 = dest->findEdge(source->getName());
-                    if (dest == nullptr) {
-                        continue;
-                    }
-                }
-                dest->setPrev(edge2);
-                dest->getSentinel()->setBase(source);
-            } else {
-                dest->setPrev(edge1);
-                dest->getSentinel()->setBase(source);
-            }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() -
+                                                  begin)
+                             .count();
+        if (threads == 1) {
+            single = seconds;
+        }
+        cerr << engine << " threads: " << threads << " seconds: " << seconds
+             << " speedup: " << (seconds > 0 ? single / seconds : 0) << endl;
+    }
+}
 
-            uptrees[dest->getSentinel()] = uptree;
+/**
+ * Times every engine once and reports each one's time, working memory,
+ * number of edges and total weight to standard error, so that they can be
+ * checked to agree
+ * Params:
+ *  - graph: the graph of all actors
+ *  - numThreads: the number of threads the engines may use
+ *  - memoryBudget: the most bytes of edges the external engine may hold
+ *  - forest: if true, spans every component
+ * Returns: void
+ */
+void reportBenchmark(ActorGraph& graph, int numThreads, size_t memoryBudget,
+                     bool forest) {
+    for (const char* engine : ENGINES) {
+        vector<Edge*> shortest;
+        size_t workBytes;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        if (!findTree(graph, engine, numThreads, memoryBudget, forest,
+                      shortest, workBytes)) {
+            cerr << engine << " failed" << endl;
             continue;
         }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() -
+                                                  begin)
+                             .count();
+        long weight = 0;
+        for (int edge = 0; edge < (int)shortest.size(); edge++) {
+            weight += shortest[edge]->getWeight();
+        }
+        cerr << engine << " seconds: " << seconds << " bytes: " << workBytes
+             << " edges: " << shortest.size() << " weight: " << weight << endl;
+    }
+}
 
-        dest->setPrev(edge1);
-
-        source->setSentinel(source);
-        dest->setSentinel(source);
-        source->setBase(dest);
-        unordered_set<Node*> uptree = {source, dest};
-        uptrees[source] = uptree;
-        thePath.push_back(edge1);
+/**
+ * Writes the number of actors, edges and total weight of each component's
+ * tree in a spanning forest, largest component first
+ * Params:
+ *  - out: the output writer
+ *  - graph: the graph of all actors
+ *  - edges: the number of forest edges in each component
+ *  - weights: the total weight of the forest edges in each component
+ * Returns: void
+ */
+void printComponents(BufferedWriter& out, ActorGraph& graph,
+                     vector<int>& edges, vector<long>& weights) {
+    vector<int> sizes = graph.getComponentSizes();
+    edges.resize(sizes.size(), 0);
+    weights.resize(sizes.size(), 0);
+    vector<int> order(sizes.size());
+    for (int component = 0; component < (int)order.size(); component++) {
+        order[component] = component;
     }
-    Node* current = uptrees.begin()->first->getBase();
-    if (current == nullptr) {
-        return {};
+    stable_sort(order.begin(), order.end(),
+                [&sizes](int lhs, int rhs) { return sizes[lhs] > sizes[rhs]; });
+    for (int component : order) {
+        out << COMPONENTLINE << component << NODES << sizes[component] << EDGES
+            << edges[component] << WEIGHTS << weights[component] << '\n';
     }
+}
 
-    return thePath;
+/**
+ * Adds batches of new cast rows to the graph, keeping the minimum spanning
+ * forest up to date with an IncrementalMST, and reports the time of each
+ * update. When benchmarking, the forest is also found again from scratch to
+ * report that time and weight next to it.
+ * Params:
+ *  - graph: the graph of all actors
+ *  - engine: the engine used to recompute the forest for comparison
+ *  - numThreads: the number of threads the engine may use
+ *  - memoryBudget: the most bytes of edges the external engine may hold
+ *  - batches: the files of new rows, one per batch
+ *  - benchmark: whether to compare each update with finding the forest again
+ *  - shortest: the minimum spanning forest of the graph, replaced by the
+ *              forest after every batch
+ * Returns: false if a batch could not be read, otherwise true
+ */
+bool runUpdates(ActorGraph& graph, string engine, int numThreads,
+                size_t memoryBudget, vector<string>& batches, bool benchmark,
+                vector<Edge*>& shortest) {
+    IncrementalMST incremental;
+    for (int edge = 0; edge < (int)shortest.size(); edge++) {
+        incremental.addEdge(shortest[edge]);
+    }
+
+    for (int batch = 0; batch < (int)batches.size(); batch++) {
+        vector<Edge*> newEdges;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        if (!graph.addFromFile(batches[batch].c_str(), newEdges)) {
+            return false;
+        }
+        chrono::steady_clock::time_point loaded = chrono::steady_clock::now();
+        int changes = 0;
+        for (int edge = 0; edge < (int)newEdges.size(); edge++) {
+            changes += incremental.addEdge(newEdges[edge]);
+        }
+        chrono::steady_clock::time_point updated = chrono::steady_clock::now();
+
+        cerr << batches[batch] << " new edges: " << newEdges.size()
+             << " forest changes: " << changes << " load seconds: "
+             << chrono::duration<double>(loaded - begin).count()
+             << " update seconds: "
+             << chrono::duration<double>(updated - loaded).count()
+             << " weight: " << incremental.getWeight();
+        if (benchmark) {
+            vector<Edge*> recomputed;
+            size_t workBytes;
+            findTree(graph, engine, numThreads, memoryBudget, true, recomputed,
+                     workBytes);
+            chrono::steady_clock::time_point finished =
+                chrono::steady_clock::now();
+            long weight = 0;
+            for (int edge = 0; edge < (int)recomputed.size(); edge++) {
+                weight += recomputed[edge]->getWeight();
+            }
+            cerr << " recompute seconds: "
+                 << chrono::duration<double>(finished - updated).count()
+                 << " recomputed weight: " << weight;
+        }
+        cerr << endl;
+    }
+    shortest = incremental.getEdges();
+    return true;
 }
 
 /**
@@ -231,33 +465,159 @@ vector<Edge*> findShortestPath(
  *  - argc: the number of command line arguments (should be 2)
  *  - argv: contents of the command line arguments: should be the name of
  *          all actors and movies they have played in, and the second
- *          argument should be the output file path
+ *          argument should be the output file path. Optionally --engine
+ *          picks how the tree is found, --threads how many threads it uses,
+ *          --scaling reports its time with more and more threads,
+ *          --benchmark times every engine, --forest spans every component
+ *          instead of only Kevin Bacon's, --update adds batches of new
+ *          movies to the forest one at a time, comparing each with finding
+ *          the forest again under --benchmark, and --memory-budget limits
+ *          the edges the external engine holds in memory. The external
+ *          engine alone, without --update, --scaling or --benchmark, loads
+ *          only the casts and never builds the edges.
  * Returns: 0 if success, otherwise 1
  */
 int main(int argc, char* argv[]) {
+    cxxopts::Options options(argv[0], "Finds the minimum spanning tree");
+    options.add_options()(
+        "engine",
+        "How to find the tree: " HEAP_ENGINE ", " SORTED_ENGINE
+        ", " RADIX_ENGINE ", " FILTER_ENGINE ", " BORUVKA_ENGINE
+        ", " PRIM_ENGINE " or " EXTERNAL_ENGINE,
+        cxxopts::value<string>()->default_value(RADIX_ENGINE))(
+        "threads", "Number of threads to use",
+        cxxopts::value<int>()->default_value(
+            to_string(max(1, (int)thread::hardware_concurrency()))))(
+        "scaling", "Report the engine's time from 1 thread up to --threads")(
+        "benchmark", "Report the time of every engine")(
+        "forest", "Span every connected component, not just " ACTOR "'s")(
+        "update",
+        "Files of new cast rows, each added to the forest as a batch; "
+        "implies --forest",
+        cxxopts::value<vector<string>>())(
+        "memory-budget",
+        "Megabytes of edges the " EXTERNAL_ENGINE " engine may hold in memory",
+        cxxopts::value<int>()->default_value("64"));
+    unique_ptr<cxxopts::ParseResult> parsed = parseOptions(options, argc, argv);
+    if (!parsed) {
+        return EXIT_FAILURE;
+    }
+    cxxopts::ParseResult& args = *parsed;
+    string engine = args["engine"].as<string>();
+    int numThreads = max(1, args["threads"].as<int>());
+    size_t memoryBudget =
+        (size_t)max(1, args["memory-budget"].as<int>()) * MEGABYTE;
+
+    bool forest = args.count("forest") > 0 || args.count("update") > 0;
+    if (find(begin(ENGINES), end(ENGINES), engine) == end(ENGINES)) {
+        cerr << "Unknown engine " << engine << endl;
+        return EXIT_FAILURE;
+    }
+
+    // The external engine alone reads only the casts, so when it is the only
+    // engine run the Edges between costars are never built
+    bool updating = args.count("update") > 0;
+    bool castsOnly = engine == EXTERNAL_ENGINE && !updating &&
+                     !args.count("scaling") && !args.count("benchmark");
     ActorGraph graph;
-    graph.loadFromFile(argv[MOVIEFILE], true);
-    priority_queue<Edge*, vector<Edge*>, EdgeComp> edges = findEdges(graph);
+    if (castsOnly) {
+        graph.loadCastsFromFile(argv[MOVIEFILE]);
+    } else {
+        graph.loadFromFile(argv[MOVIEFILE], true);
+    }
+    Node* start = graph.getActorNode(ACTOR);
+    if (!start && !forest) {
+        // Nothing to start the traversal from
+        cerr << ACTOR << " is not in the graph; spanning every component"
+             << endl;
+        forest = true;
+    } else if (!forest && graph.getNumComponents() > 1) {
+        // The traversal only reaches the starting actor's component
+        cerr << "Graph has " << graph.getNumComponents()
+             << " connected components; spanning the "
+             << graph.getComponentSizes()[graph.getComponent(start)]
+             << " actors connected to " << ACTOR << endl;
+    }
 
-    vector<Edge*> shortest = findShortestPath(edges);
     ofstream os;
     os.open(argv[OUTFILE]);
+    BufferedWriter out(os);
+    out << HEADER << '\n';
+
+    // Prints each edge as soon as the engine chooses it, keeping only totals
+    long numEdges = 0;
+    long weight = 0;
+    vector<int> componentEdges;
+    vector<long> componentWeights;
+    auto printLine = [&](Node* source, Movie movie, Node* dest,
+                         int edgeWeight) {
+        out << OPENING << source->getName() << ACTORMOVIE << movie.name
+            << MOVIE_YEAR << movie.year << MOVIEACTOR << dest->getName()
+            << CLOSING << '\n';
+        numEdges++;
+        weight += edgeWeight;
+        if (forest) {
+            int component = graph.getComponent(source);
+            if (component >= (int)componentEdges.size()) {
+                componentEdges.resize(component + 1, 0);
+                componentWeights.resize(component + 1, 0);
+            }
+            componentEdges[component]++;
+            componentWeights[component] += edgeWeight;
+        }
+    };
+    EdgeSink printEdge = [&](Edge* edge) {
+        printLine(edge->getSource(), edge->getName(), edge->getDest(),
+                  edge->getWeight());
+    };
+    RecordSink printRecord = [&](const EdgeRecord& record) {
+        printLine(graph.getActorById(record.source),
+                  graph.getMovieById(record.movie),
+                  graph.getActorById(record.dest), record.weight);
+    };
 
-    // prints to file
-    os << HEADER << endl;
-    int weight = 0;
-    for (int edge = 0; edge < shortest.size(); edge++) {
-        // prints each edge
-        os << OPENING << shortest[edge]->getSource()->getName() << ACTORMOVIE
-           << shortest[edge]->getName().name << MOVIE_YEAR
-           << shortest[edge]->getName().year << MOVIEACTOR
-           << shortest[edge]->getDest()->getName() << CLOSING << endl;
-        weight += shortest[edge]->getWeight();
+    // Updates replace the whole forest, so it is only printed at the end
+    vector<Edge*> shortest;
+    size_t workBytes;
+    bool found;
+    if (castsOnly) {
+        found = findExternalForest(graph,
+                                   forest ? -1 : graph.getComponent(start),
+                                   memoryBudget, printRecord, &workBytes);
+    } else {
+        found = findTree(graph, engine, numThreads, memoryBudget, forest,
+                         shortest, workBytes, updating ? nullptr : printEdge);
+    }
+    if (!found) {
+        cerr << "The " << engine << " engine could not find the tree" << endl;
+        return EXIT_FAILURE;
+    }
+    if (args.count("scaling")) {
+        reportScaling(graph, engine, numThreads, memoryBudget, forest);
+    }
+    if (args.count("benchmark")) {
+        reportBenchmark(graph, numThreads, memoryBudget, forest);
+    }
+    if (updating) {
+        vector<string> batches = args["update"].as<vector<string>>();
+        if (!runUpdates(graph, engine, numThreads, memoryBudget, batches,
+                        args.count("benchmark") > 0, shortest)) {
+            return EXIT_FAILURE;
+        }
+        for (int edge = 0; edge < (int)shortest.size(); edge++) {
+            printEdge(shortest[edge]);
+        }
     }
 
-    os << FIRSTLINE << (shortest.size() + 1) << endl;
-    os << SECONDLINE << (shortest.size()) << endl;
-    os << THIRDLINE << weight << endl;
+    if (forest) {
+        printComponents(out, graph, componentEdges, componentWeights);
+    }
+    // A forest connects one more actor than edges in each component
+    out << FIRSTLINE << numEdges + (forest ? graph.getNumComponents() : 1)
+        << '\n';
+    out << SECONDLINE << numEdges << '\n';
+    out << THIRDLINE << weight << '\n';
+    out.flush();
 
     graph.clear();
     os.close();
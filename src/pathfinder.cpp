@@ -7,12 +7,20 @@
  * finds the shortest path between two actors
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <sstream>
+#include <unordered_map>
 
 #include "ActorGraph.hpp"
+#include "ExclusionMask.hpp"
+#include "Options.hpp"
+#include "PathTreeCache.hpp"
+#include "TemporalPaths.hpp"
+#include "cxxopts.hpp"
 
 // argv positions
 #define MOVIE_FILE 1
@@ -20,9 +28,10 @@
 #define ACTOR_FILE 3
 #define OUTPUT_FILE 4
 
-// unweighted vs. weighted flags
+// unweighted vs. weighted vs. time-respecting flags
 #define UNWEIGHTED 'u'
 #define WEIGHTED 'w'
+#define TEMPORAL 't'
 
 // Delimiters in outputing paths
 #define ACT_MOV "--"
@@ -33,26 +42,43 @@
 #define RIGHT_MOV_BRACE "]"
 #define NAME_YEAR "#@"
 
+// Separates the actors and movies to avoid in the third column of the pairs
+#define EXCLUDE_DELIM '|'
+
 #define HEADER "(actor)--[movie#@year]]-->(actor)--..."
 
 using namespace std;
 
+void buildMask(ActorGraph& graph, string exclude, ExclusionMask& mask);
+
 /**
  * Finds closest weighted path between actor1 and actor2
  * Params:
  *  - graph: graphs of all actors
  *  - actor1: the actor the path starts from
  *  - actor2: the actor the path ends at
+ *  - fromYear: the earliest year of a movie the path may use
+ *  - toYear: the latest year of a movie the path may use
+ *  - mask: the actors and movies the path must avoid, or nullptr
  *  Returns: a vector of edges that traces the path from actor1 to actor2
  */
-vector<Edge*> findWeightedPath(ActorGraph& graph, string actor1,
-                               string actor2) {
+vector<Edge*> findWeightedPath(ActorGraph& graph, string actor1, string actor2,
+                               int fromYear, int toYear, ExclusionMask* mask) {
     Node* start = graph.getActorNode(actor1);
     Node* end = graph.getActorNode(actor2);
     if (!start || !end) {
         // if start or end not found
         return {};
     }
+    if (graph.getComponent(start) != graph.getComponent(end)) {
+        // No path can join different components
+        return {};
+    }
+    if (mask && (mask->excludesActor(start->getId()) ||
+                 mask->excludesActor(end->getId()))) {
+        // start or end must be avoided
+        return {};
+    }
     priority_queue<pair<Node*, int>, vector<pair<Node*, int>>, NodePairComp>
         djikstra;
     unordered_map<Node*, int> changed;
@@ -69,17 +95,23 @@ vector<Edge*> findWeightedPath(ActorGraph& graph, string actor1,
             continue;
         }
         current->check();
-        vector<Edge*> neighbors = current->getEdges();
-        for (int edge = 0; edge < neighbors.size(); edge++) {
-            if (neighbors[edge]->getDest()->isDone()) {
+        pair<EdgeIter, EdgeIter> neighbors =
+            current->getEdgesInYears(fromYear, toYear);
+        for (EdgeIter edge = neighbors.first; edge != neighbors.second;
+             edge++) {
+            if ((*edge)->getDest()->isDone()) {
                 // Node already checked, can't be shortest distance
                 continue;
             }
-            if (neighbors[edge]->getDest()->getPathWeight() >
-                current->getPathWeight() + neighbors[edge]->getWeight()) {
+            if (mask && mask->excludes(*edge)) {
+                // Movie or actor must be avoided
+                continue;
+            }
+            if ((*edge)->getDest()->getPathWeight() >
+                current->getPathWeight() + (*edge)->getWeight()) {
                 // Found a shorter path to the node
-                Node* neighbor = neighbors[edge]->getDest();
-                neighbor->setPrev(neighbors[edge], current->getPathWeight());
+                Node* neighbor = (*edge)->getDest();
+                neighbor->setPrev(*edge, current->getPathWeight());
                 changed[neighbor] = 1;  // Adds to changed list so Node can be
                                         // reset when path found
                 if (neighbor == end) {
@@ -102,7 +134,10 @@ vector<Edge*> findWeightedPath(ActorGraph& graph, string actor1,
             }
         }
     }
-    // No path found
+    // No path found, resets all nodes
+    for (auto iter = changed.begin(); iter != changed.end(); iter++) {
+        iter->first->uncheck();
+    }
     return {};
 }
 
@@ -112,16 +147,29 @@ vector<Edge*> findWeightedPath(ActorGraph& graph, string actor1,
  * - graph: the graph of all actors
  * - actor1: the name of first actor
  * - actor2: the name of second actor
+ * - fromYear: the earliest year of a movie the path may use
+ * - toYear: the latest year of a movie the path may use
+ * - mask: the actors and movies the path must avoid, or nullptr
  * Returns: a vector of edges representing the path from actor1 to actor2
  */
 vector<Edge*> findUnweightedPath(ActorGraph& graph, string actor1,
-                                 string actor2) {
+                                 string actor2, int fromYear, int toYear,
+                                 ExclusionMask* mask) {
     Node* start = graph.getActorNode(actor1);
     Node* end = graph.getActorNode(actor2);
     if (!start || !end) {
         // if start or end not found
         return {};
     }
+    if (graph.getComponent(start) != graph.getComponent(end)) {
+        // No path can join different components
+        return {};
+    }
+    if (mask && (mask->excludesActor(start->getId()) ||
+                 mask->excludesActor(end->getId()))) {
+        // start or end must be avoided
+        return {};
+    }
 
     queue<Node*> bfs;
     bfs.push(start);
@@ -152,11 +200,17 @@ vector<Edge*> findUnweightedPath(ActorGraph& graph, string actor1,
             return path;
         }
 
-        vector<Edge*> neighborEdges = current->getEdges();
+        pair<EdgeIter, EdgeIter> neighborEdges =
+            current->getEdgesInYears(fromYear, toYear);
 
-        for (int edge = 0; edge < neighborEdges.size(); edge++) {
+        for (EdgeIter edge = neighborEdges.first; edge != neighborEdges.second;
+             edge++) {
             // Pushes neighbors onto queue
-            Node* neighbor = neighborEdges[edge]->getDest();
+            if (mask && mask->excludes(*edge)) {
+                // Movie or actor must be avoided
+                continue;
+            }
+            Node* neighbor = (*edge)->getDest();
             finished[neighbor] = 1;  // adds Node to changed list so it can be
                                      // reset when path found
 
@@ -167,7 +221,7 @@ vector<Edge*> findUnweightedPath(ActorGraph& graph, string actor1,
             if (neighbor->getPrev() == nullptr) {
                 // only changes previous once
 
-                neighbor->setPrev(neighborEdges[edge]);
+                neighbor->setPrev(*edge);
             }
             if (neighbor == end) {
                 vector<Edge*> path;
@@ -194,6 +248,48 @@ vector<Edge*> findUnweightedPath(ActorGraph& graph, string actor1,
     return {};  // Path not found
 }
 
+/**
+ * Finds the time-respecting path for every pair of actors, running a single
+ * sweep for each distinct starting actor and list of exclusions
+ * Params:
+ * - graph: the graph of all actors
+ * - actors: the pairs of actors to find paths between
+ * - exclusions: the actors and movies each pair's path must avoid
+ * - fromYear: the earliest year of a movie the paths may use
+ * - toYear: the latest year of a movie the paths may use
+ * Returns: a vector of paths in the same order as actors
+ */
+vector<vector<Edge*>> findAllTemporalPaths(ActorGraph& graph,
+                                           vector<pair<string, string>>& actors,
+                                           vector<string>& exclusions,
+                                           int fromYear, int toYear) {
+    // Groups the pairs by the actor the path starts from
+    map<pair<string, string>, vector<int>> bySource;
+    for (int test = 0; test < (int)actors.size(); test++) {
+        bySource[{actors[test].first, exclusions[test]}].push_back(test);
+    }
+
+    vector<vector<Edge*>> paths(actors.size());
+    vector<int> arrival(graph.getNumActors(), UNREACHED);
+    vector<Edge*> prev(graph.getNumActors(), nullptr);
+    ExclusionMask mask(graph.getNumActors(), graph.getNumMovies());
+    for (auto iter = bySource.begin(); iter != bySource.end(); iter++) {
+        vector<string> targets;
+        for (int test = 0; test < (int)iter->second.size(); test++) {
+            targets.push_back(actors[iter->second[test]].second);
+        }
+        mask.clear();
+        buildMask(graph, iter->first.second, mask);
+        vector<vector<Edge*>> found = findTemporalPaths(
+            graph, iter->first.first, targets, fromYear, toYear, arrival, prev,
+            mask.isEmpty() ? nullptr : &mask);
+        for (int test = 0; test < (int)iter->second.size(); test++) {
+            paths[iter->second[test]] = found[test];
+        }
+    }
+    return paths;
+}
+
 /**
  * Resets all edges so that they are no longer checked; called after path is
  * found
@@ -212,9 +308,12 @@ void clearEdges(vector<Edge*> edges) {
  * Parses test file to extract actor pairs within it
  * Params:
  * - testfile: name of testfile
+ * - exclusions: filled with the optional third column of each pair, listing
+ *               the actors and movies (as movie#@year) its path must avoid
  * Returns: a vector of pairs containing actor pairs
  */
-vector<pair<string, string>> parsePathFile(string testFile) {
+vector<pair<string, string>> parsePathFile(string testFile,
+                                           vector<string>& exclusions) {
     // Initialize the file stream
     ifstream infile(testFile);
     vector<pair<string, string>> actorList;
@@ -236,6 +335,7 @@ vector<pair<string, string>> parsePathFile(string testFile) {
 
         stringstream ss(line);
         pair<string, string> actors;
+        string exclude;
         int pos = 1;
 
         while (ss) {
@@ -249,8 +349,10 @@ vector<pair<string, string>> parsePathFile(string testFile) {
             if (pos == 1) {  // first actor
                 actors.first = str;
 
-            } else {  // second actor
+            } else if (pos == 2) {  // second actor
                 actors.second = str;
+            } else {  // actors and movies to avoid
+                exclude = str;
             }
             pos++;
         }
@@ -258,60 +360,211 @@ vector<pair<string, string>> parsePathFile(string testFile) {
             continue;
         }
         actorList.push_back(actors);
+        exclusions.push_back(exclude);
     }
     infile.close();
     return actorList;
 }
 
+/**
+ * Fills a mask with the actors and movies listed in a pairs file column,
+ * separated by EXCLUDE_DELIM. Movies are given as movie#@year like in the
+ * output, and anything else is taken as the name of an actor. Names that are
+ * not in the graph are ignored.
+ * Params:
+ * - graph: the graph of all actors
+ * - exclude: the list of actors and movies to avoid
+ * - mask: the cleared mask to fill
+ * Returns: void
+ */
+void buildMask(ActorGraph& graph, string exclude, ExclusionMask& mask) {
+    stringstream ss(exclude);
+    string item;
+    while (getline(ss, item, EXCLUDE_DELIM)) {
+        size_t yearPos = item.rfind(NAME_YEAR);
+        if (yearPos != string::npos) {
+            // movie#@year is stored under the title "movie year"
+            int movie = graph.getMovieId(item.substr(0, yearPos) + " " +
+                                         item.substr(yearPos + 2));
+            if (movie != -1) {
+                mask.excludeMovie(movie);
+            }
+            continue;
+        }
+        Node* actor = graph.getActorNode(item);
+        if (actor) {
+            mask.excludeActor(actor->getId());
+        }
+    }
+}
+
+/**
+ * Answers a pair from the cache of shortest path trees. A tree is built for
+ * an endpoint that is hot, meaning it appears in at least minQueries pairs.
+ * Params:
+ * - cache: the cache of shortest path trees
+ * - graph: the graph of all actors
+ * - actors: the pair of actors to find the path between
+ * - weighted: if the path uses edge weights
+ * - queryCounts: the number of pairs each actor appears in
+ * - minQueries: the number of pairs that makes an actor hot
+ * - path: filled with the edges of the path
+ * - reversed: set to true if the edges must be printed from destination to
+ *             source
+ * Returns: true if the pair was answered from a tree
+ */
+bool findCachedPath(PathTreeCache& cache, ActorGraph& graph,
+                    pair<string, string>& actors, bool weighted,
+                    unordered_map<string, int>& queryCounts, int minQueries,
+                    vector<Edge*>& path, bool& reversed) {
+    Node* start = graph.getActorNode(actors.first);
+    Node* end = graph.getActorNode(actors.second);
+    if (!start || !end ||
+        graph.getComponent(start) != graph.getComponent(end)) {
+        // Point searches return right away for these
+        return false;
+    }
+    if (cache.findPath(start->getId(), end->getId(), weighted,
+                       queryCounts[actors.first] >= minQueries, path,
+                       reversed)) {
+        return true;
+    }
+    if (queryCounts[actors.second] < minQueries ||
+        !cache.findPath(end->getId(), start->getId(), weighted, true, path,
+                        reversed)) {
+        return false;
+    }
+    // Turns the path from end to start around
+    reverse(path.begin(), path.end());
+    reversed = !reversed;
+    return true;
+}
+
+/**
+ * Prints a path in the (actor)--[movie#@year]-->(actor) format
+ * Params:
+ * - output: the stream to print to
+ * - path: the edges of the path
+ * - reversed: if each edge goes from the later actor to the earlier one
+ * Returns: void
+ */
+void printPath(ofstream& output, vector<Edge*>& path, bool reversed) {
+    for (int edge = 0; edge < (int)path.size(); edge++) {
+        Node* from = reversed ? path[edge]->getDest() : path[edge]->getSource();
+        Node* to = reversed ? path[edge]->getSource() : path[edge]->getDest();
+        if (edge == 0) {  // If printing first actor in path
+            output << LEFT_BRACE << from->getName()
+                   << RIGHT_BRACE;  // prints first actor
+        }
+        output << ACT_MOV;  // prints first delimiter
+        output << LEFT_MOV_BRACE << path[edge]->getName().name << NAME_YEAR
+               << path[edge]->getName().year
+               << RIGHT_MOV_BRACE;  // prints movie and year
+        output << MOV_ACT;          // prints second delimiter
+        output << LEFT_BRACE << to->getName()
+               << RIGHT_BRACE;  // prints second actor
+    }
+}
+
 /**
  * Runs pathfinder to find the shortest path between two actors
  * Params:
  *  - argc: the number of command line arguments (should be 4)
  *  - argv: contents of the command line arguments: should be movie file name
- *          u or w for weighted/unweighted, file name of file containing actor
- *          pairs, and output file name Returns: 0 if success, otherwise 1
+ *          u or w for weighted/unweighted (or t for paths whose movies never
+ *          go back in time), file name of file containing actor pairs, and
+ *          output file name. Each pair may list actors and movies its path
+ *          must avoid in a third column. Optionally --from-year and --to-year
+ *          limit the paths to movies from a range of years, and
+ *          --cache-size keeps the shortest path trees of hot actors.
+ *          Returns: 0 if success, otherwise 1
  */
 int main(int argc, char* argv[]) {
+    cxxopts::Options options(argv[0], "Finds shortest paths between actors");
+    options.add_options()(
+        "from-year", "Only use movies from this year or later",
+        cxxopts::value<int>()->default_value(to_string(MIN_YEAR)))(
+        "to-year", "Only use movies from this year or earlier",
+        cxxopts::value<int>()->default_value(to_string(MAX_YEAR)))(
+        "cache-size", "Number of shortest path trees of hot actors to keep",
+        cxxopts::value<int>()->default_value("0"))(
+        "cache-min-queries", "Number of pairs an actor must be in to be hot",
+        cxxopts::value<int>()->default_value("2"));
+    unique_ptr<cxxopts::ParseResult> parsed = parseOptions(options, argc, argv);
+    if (!parsed) {
+        return EXIT_FAILURE;
+    }
+    cxxopts::ParseResult& args = *parsed;
+    int fromYear = args["from-year"].as<int>();
+    int toYear = args["to-year"].as<int>();
+    int cacheSize = args["cache-size"].as<int>();
+    int minQueries = args["cache-min-queries"].as<int>();
+
     ActorGraph graph;
-    if (argv[UW][0] == UNWEIGHTED) {
+    if (argv[UW][0] == UNWEIGHTED || argv[UW][0] == TEMPORAL) {
         graph.loadFromFile(argv[MOVIE_FILE], false);
     } else if (argv[UW][0] == WEIGHTED) {
         graph.loadFromFile(argv[MOVIE_FILE], true);
     }
-    vector<pair<string, string>> actors = parsePathFile(argv[ACTOR_FILE]);
+    vector<string> exclusions;
+    vector<pair<string, string>> actors =
+        parsePathFile(argv[ACTOR_FILE], exclusions);
+    ExclusionMask mask(graph.getNumActors(), graph.getNumMovies());
+    PathTreeCache cache(graph, cacheSize, fromYear, toYear);
+    unordered_map<string, int> queryCounts;  // Number of pairs of each actor
+    for (int test = 0; test < (int)actors.size(); test++) {
+        if (exclusions[test].empty()) {
+            queryCounts[actors[test].first]++;
+            queryCounts[actors[test].second]++;
+        }
+    }
 
     ofstream output;
     output.open(argv[OUTPUT_FILE]);
     output << HEADER << endl;
     // cout << actors.size() << endl;
+    vector<vector<Edge*>> temporalPaths;
+    if (argv[UW][0] == TEMPORAL) {
+        // Answers the whole batch at once, one sweep per starting actor
+        temporalPaths =
+            findAllTemporalPaths(graph, actors, exclusions, fromYear, toYear);
+    }
     for (int test = 0; test < actors.size(); test++) {
         vector<Edge*> path;
-        if (argv[UW][0] == UNWEIGHTED) {
+        bool reversed = false;
+        // Reuses one mask, only touching the bits of this pair's exclusions
+        mask.clear();
+        buildMask(graph, exclusions[test], mask);
+        ExclusionMask* pathMask = mask.isEmpty() ? nullptr : &mask;
+        if (argv[UW][0] == TEMPORAL) {
+            path = temporalPaths[test];
+        } else if (cacheSize > 0 && !pathMask &&
+                   findCachedPath(cache, graph, actors[test],
+                                  argv[UW][0] == WEIGHTED, queryCounts,
+                                  minQueries, path, reversed)) {
+            // Answered from a shortest path tree
+        } else if (argv[UW][0] == UNWEIGHTED) {
             path = findUnweightedPath(graph, actors[test].first,
-                                      actors[test].second);
+                                      actors[test].second, fromYear, toYear,
+                                      pathMask);
         } else if (argv[UW][0] == WEIGHTED) {
             path = findWeightedPath(graph, actors[test].first,
-                                    actors[test].second);
+                                    actors[test].second, fromYear, toYear,
+                                    pathMask);
         }
         if (path.size() == 0) {
             output << endl;
             continue;
         }
-        for (int edge = 0; edge < path.size(); edge++) {
-            if (edge == 0) {  // If printing first actor in path
-                output << LEFT_BRACE << path[edge]->getSource()->getName()
-                       << RIGHT_BRACE;  // prints first actor
-            }
-            output << ACT_MOV;  // prints first delimiter
-            output << LEFT_MOV_BRACE << path[edge]->getName().name << NAME_YEAR
-                   << path[edge]->getName().year
-                   << RIGHT_MOV_BRACE;  // prints movie and year
-            output << MOV_ACT;          // prints second delimiter
-            output << LEFT_BRACE << path[edge]->getDest()->getName()
-                   << RIGHT_BRACE;  // prints second actor
-        }
+        printPath(output, path, reversed);
         output << endl;  // prints new line
     }
+    if (cacheSize > 0) {
+        cerr << "Path tree cache: " << cache.getHits() << " hits, "
+             << cache.getMisses() << " trees built, hit rate "
+             << cache.getHitRate() << ", " << cache.getMemoryBytes()
+             << " bytes" << endl;
+    }
     graph.clear();
     output.close();
 }
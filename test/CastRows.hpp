@@ -0,0 +1,79 @@
+/**
+ * File Header
+ * Author: Anthony Yang
+ * Email: a5yang@ucsd.edu
+ * Sources: None
+ * Description: This file contains the small casts the tests build graphs from,
+ * and the helpers that add them to a graph.
+ */
+
+#ifndef CASTROWS_HPP
+#define CASTROWS_HPP
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ActorGraph.hpp"
+
+using namespace std;
+
+// Movies of the actors A to G, with ids in that order. A and B share two
+// movies, so their weights differ from the counts.
+const vector<vector<string>> BASE_ROWS = {
+    {"A", "One", "2000"},   {"B", "One", "2000"},   {"C", "One", "2000"},
+    {"A", "Two", "2001"},   {"D", "Two", "2001"},   {"B", "Two", "2001"},
+    {"D", "Three", "2002"}, {"E", "Three", "2002"}, {"B", "Four", "2003"},
+    {"E", "Four", "2003"},  {"F", "Four", "2003"},  {"C", "Five", "2004"},
+    {"G", "Five", "2004"}};
+
+/**
+ * Adds rows of actor, movie and year to a graph
+ * Params:
+ * - graph: the graph
+ * - rows: the rows
+ * - newEdges: if not nullptr, filled with the new edges
+ * Returns: void
+ */
+inline void addRows(ActorGraph& graph, const vector<vector<string>>& rows,
+                    vector<Edge*>* newEdges = nullptr) {
+    for (const vector<string>& row : rows) {
+        graph.addCastRow(row[0], row[1], row[2], newEdges);
+    }
+}
+
+/**
+ * Loads rows of actor, movie and year into an empty graph through a file, so
+ * the graph is indexed and its components labeled as after loadFromFile
+ * Params:
+ * - graph: the empty graph
+ * - rows: the rows
+ * - fileName: the file the rows are written to and removed from, unique to
+ *             the test so tests can run at once
+ * Returns: true if the graph was loaded
+ */
+inline bool loadRows(ActorGraph& graph, const vector<vector<string>>& rows,
+                     const char* fileName) {
+    ofstream out(fileName);
+    out << "Actor/Actress\tMovie\tYear" << endl;
+    for (const vector<string>& row : rows) {
+        out << row[0] << '\t' << row[1] << '\t' << row[2] << endl;
+    }
+    out.close();
+    bool loaded = graph.loadFromFile(fileName, true);
+    remove(fileName);
+    return loaded;
+}
+
+class SmallCastGraph : public ::testing::Test {
+  protected:
+    ActorGraph graph;
+
+  public:
+    SmallCastGraph() { addRows(graph, BASE_ROWS); }
+    ~SmallCastGraph() { graph.clear(); }
+};
+
+#endif
@@ -73,3 +73,34 @@ TEST_F(SimpleActorGraph, TEST_GET_CAST_NOT_IN_LIST) {
 
     ASSERT_EQ(graph.getMovieCast(movie).size(), 0);
 }*/
+
+TEST(NodeYearIndex, TEST_EDGES_IN_YEARS) {
+    Node actor("Actor");
+    Node other("Other");
+    Movie movies[] = {{"C 2001", "C", 2001, 0},
+                      {"A 1990", "A", 1990, 1},
+                      {"B 1995", "B", 1995, 2}};
+    for (int movie = 0; movie < 3; movie++) {
+        actor.addEdge(new Edge(&actor, &other, movies[movie]));
+    }
+    actor.indexByYear();
+
+    // Full range keeps the order the edges were added in
+    pair<EdgeIter, EdgeIter> all = actor.getEdgesInYears(MIN_YEAR, MAX_YEAR);
+    ASSERT_EQ(all.second - all.first, 3);
+    ASSERT_EQ((*all.first)->getYear(), 2001);
+
+    pair<EdgeIter, EdgeIter> some = actor.getEdgesInYears(1991, 2001);
+    ASSERT_EQ(some.second - some.first, 2);
+    ASSERT_EQ((*some.first)->getYear(), 1995);
+
+    pair<EdgeIter, EdgeIter> none = actor.getEdgesInYears(2002, 2010);
+    ASSERT_EQ(none.second - none.first, 0);
+
+    // An edge added later is in range without indexing again
+    Movie later = {"D 1995", "D", 1995, 3};
+    actor.addEdge(&other, later);
+    some = actor.getEdgesInYears(1995, 1995);
+    ASSERT_EQ(some.second - some.first, 2);
+    ASSERT_EQ((*(some.first + 1))->getMovieId(), 3);
+}
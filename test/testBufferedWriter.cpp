@@ -0,0 +1,65 @@
+#include <climits>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "BufferedWriter.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(BufferedWriterTests, TEST_INTEGERS) {
+    ostringstream out;
+    {
+        BufferedWriter writer(out);
+        writer << 0 << ' ' << -7 << ' ' << 42 << ' ' << INT_MIN << ' '
+               << INT_MAX << ' ' << LONG_MIN << ' ' << LONG_MAX << ' '
+               << -10L << ' ' << 100L;
+    }
+    ostringstream expected;
+    expected << 0 << ' ' << -7 << ' ' << 42 << ' ' << INT_MIN << ' '
+             << INT_MAX << ' ' << LONG_MIN << ' ' << LONG_MAX << ' ' << -10L
+             << ' ' << 100L;
+    ASSERT_EQ(out.str(), expected.str());
+}
+
+TEST(BufferedWriterTests, TEST_TEXT_AND_FLUSH) {
+    ostringstream out;
+    BufferedWriter writer(out);
+    writer << "Kevin Bacon" << '\t' << string("(Footloose)") << '\n';
+    // Nothing reaches the stream until the writer flushes
+    ASSERT_EQ(out.str(), "");
+    writer.flush();
+    ASSERT_EQ(out.str(), "Kevin Bacon\t(Footloose)\n");
+    writer.flush();
+    ASSERT_EQ(out.str(), "Kevin Bacon\t(Footloose)\n");
+}
+
+TEST(BufferedWriterTests, TEST_FLUSH_BOUNDARY) {
+    ostringstream out;
+    BufferedWriter writer(out);
+    string full(WRITE_BUFFER_SIZE - 1, 'a');
+    writer << full << 'b';
+    // Exactly full, so still held
+    ASSERT_EQ(out.str(), "");
+    writer << 'c';
+    ASSERT_EQ(out.str(), full + "b");
+
+    // A number that no longer fits flushes what came before it first
+    writer << string(WRITE_BUFFER_SIZE - 6, 'd') << LONG_MIN;
+    ASSERT_EQ(out.str(), full + "b" + "c" + string(WRITE_BUFFER_SIZE - 6, 'd'));
+    writer.flush();
+    ASSERT_EQ(out.str(), full + "bc" + string(WRITE_BUFFER_SIZE - 6, 'd') +
+                             to_string(LONG_MIN));
+}
+
+TEST(BufferedWriterTests, TEST_TEXT_LONGER_THAN_BUFFER) {
+    ostringstream out;
+    string longText(WRITE_BUFFER_SIZE * 2 + 3, 'x');
+    {
+        BufferedWriter writer(out);
+        writer << "before " << longText << " after " << 5;
+        ASSERT_EQ(out.str(), "before " + longText);
+    }
+    ASSERT_EQ(out.str(), "before " + longText + " after 5");
+}
@@ -0,0 +1,41 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ConcurrentDisjointSet.hpp"
+#include "DisjointSet.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(DisjointSetTests, TEST_UNITE_AND_FIND) {
+    DisjointSet sets(6);
+    ASSERT_EQ(sets.getNumSets(), 6);
+    ASSERT_TRUE(sets.unite(0, 1));
+    ASSERT_TRUE(sets.unite(2, 3));
+    ASSERT_TRUE(sets.unite(1, 3));
+    ASSERT_FALSE(sets.unite(0, 2));
+    ASSERT_EQ(sets.find(0), sets.find(3));
+    ASSERT_NE(sets.find(0), sets.find(4));
+    ASSERT_EQ(sets.getNumSets(), 3);
+}
+
+TEST(DisjointSetTests, TEST_CONCURRENT_UNITE) {
+    int size = 10000;
+    ConcurrentDisjointSet sets(size);
+    vector<thread> threads;
+    for (int part = 0; part < 4; part++) {
+        // Each thread joins a different stride of ids into odd and even sets
+        threads.push_back(thread([&sets, part, size]() {
+            for (int element = 2 + part; element < size; element += 4) {
+                sets.unite(element, element - 2);
+            }
+        }));
+    }
+    for (int part = 0; part < (int)threads.size(); part++) {
+        threads[part].join();
+    }
+    ASSERT_EQ(sets.find(size - 2), 0);
+    ASSERT_EQ(sets.find(size - 1), 1);
+    ASSERT_FALSE(sets.unite(0, 4));
+}
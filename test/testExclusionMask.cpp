@@ -0,0 +1,79 @@
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "CastRows.hpp"
+#include "ExclusionMask.hpp"
+
+using namespace std;
+using namespace testing;
+
+#define NUM_ACTORS 200
+#define NUM_MOVIES 150
+
+/**
+ * Checks that a mask excludes exactly the given actors and movies
+ * Params:
+ * - mask: the mask
+ * - actors: the ids of the actors it should exclude
+ * - movies: the ids of the movies it should exclude
+ * Returns: void
+ */
+static void expectExcluded(ExclusionMask& mask, const set<int>& actors,
+                           const set<int>& movies) {
+    for (int actor = 0; actor < NUM_ACTORS; actor++) {
+        ASSERT_EQ(mask.excludesActor(actor), actors.count(actor) == 1);
+    }
+    for (int movie = 0; movie < NUM_MOVIES; movie++) {
+        ASSERT_EQ(mask.excludesMovie(movie), movies.count(movie) == 1);
+    }
+    ASSERT_EQ(mask.isEmpty(), actors.empty() && movies.empty());
+}
+
+TEST(ExclusionMaskTests, TEST_CLEAR_RESETS_SET_BITS) {
+    ExclusionMask mask(NUM_ACTORS, NUM_MOVIES);
+    expectExcluded(mask, {}, {});
+
+    // Ids sharing a word, at the ends of words, and excluded twice
+    set<int> actors = {0, 3, 63, 64, 130, 199};
+    set<int> movies = {5, 6, 127, 149};
+    for (int actor : actors) {
+        mask.excludeActor(actor);
+    }
+    mask.excludeActor(3);
+    for (int movie : movies) {
+        mask.excludeMovie(movie);
+    }
+    expectExcluded(mask, actors, movies);
+
+    mask.clear();
+    expectExcluded(mask, {}, {});
+
+    // A reused mask holds only what the next query excludes
+    mask.excludeActor(4);
+    mask.excludeMovie(128);
+    expectExcluded(mask, {4}, {128});
+    mask.clear();
+    expectExcluded(mask, {}, {});
+}
+
+TEST_F(SmallCastGraph, TEST_MASK_EXCLUDES_EDGES) {
+    ExclusionMask mask(graph.getNumActors(), graph.getNumMovies());
+    Node* actor = graph.getActorNode("A");
+    for (Edge* edge : actor->getEdges()) {
+        ASSERT_FALSE(mask.excludes(edge));
+    }
+    // Every edge into B or through movie One is skipped
+    mask.excludeActor(graph.getActorNode("B")->getId());
+    mask.excludeMovie(actor->getEdges()[0]->getMovieId());
+    for (Edge* edge : actor->getEdges()) {
+        bool excluded = edge->getDest()->getName() == "B" ||
+                        edge->getMovieId() ==
+                            actor->getEdges()[0]->getMovieId();
+        ASSERT_EQ(mask.excludes(edge), excluded);
+    }
+    mask.clear();
+    for (Edge* edge : actor->getEdges()) {
+        ASSERT_FALSE(mask.excludes(edge));
+    }
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ActorGraph.hpp"
+#include "DisjointSet.hpp"
+#include "IncrementalMST.hpp"
+#include "LinkCutTree.hpp"
+
+using namespace std;
+using namespace testing;
+
+/**
+ * Finds the path between two vertices of a forest by depth first search
+ * Params:
+ * - adjacent: the neighbors of each vertex
+ * - first: the start of the path
+ * - second: the end of the path
+ * Returns: the vertices on the path, ends included, or empty if none
+ */
+static vector<int> findPath(vector<set<int>>& adjacent, int first,
+                            int second) {
+    vector<int> previous(adjacent.size(), NO_VERTEX);
+    vector<int> stack = {first};
+    previous[first] = first;
+    while (!stack.empty()) {
+        int vertex = stack.back();
+        stack.pop_back();
+        for (int next : adjacent[vertex]) {
+            if (previous[next] == NO_VERTEX) {
+                previous[next] = vertex;
+                stack.push_back(next);
+            }
+        }
+    }
+    vector<int> path;
+    if (previous[second] == NO_VERTEX) {
+        return path;
+    }
+    for (int vertex = second; vertex != first; vertex = previous[vertex]) {
+        path.push_back(vertex);
+    }
+    path.push_back(first);
+    return path;
+}
+
+TEST(LinkCutTreeTests, TEST_LINK_CUT_HEAVIEST) {
+    LinkCutTree forest;
+    // A path 0 - 1 - 2 - 3 with a branch 1 - 4
+    int values[] = {1, 7, 3, 5, 9};
+    for (int value : values) {
+        forest.addVertex(value);
+    }
+    ASSERT_FALSE(forest.connected(0, 3));
+    forest.link(0, 1);
+    forest.link(1, 2);
+    forest.link(3, 2);
+    forest.link(4, 1);
+    ASSERT_TRUE(forest.connected(0, 3));
+    ASSERT_EQ(forest.findHeaviest(0, 3), 1);
+    ASSERT_EQ(forest.findHeaviest(3, 2), 3);
+    ASSERT_EQ(forest.findHeaviest(3, 4), 4);
+    ASSERT_EQ(forest.findHeaviest(2, 2), 2);
+
+    forest.cut(2, 1);
+    ASSERT_FALSE(forest.connected(0, 3));
+    ASSERT_TRUE(forest.connected(3, 2));
+    ASSERT_TRUE(forest.connected(0, 4));
+
+    // A cut vertex can be given a new value once alone
+    forest.cut(3, 2);
+    forest.setValue(3, 11);
+    ASSERT_EQ(forest.getValue(3), 11);
+    forest.link(3, 0);
+    ASSERT_EQ(forest.findHeaviest(4, 3), 3);
+    ASSERT_EQ(forest.findHeaviest(4, 0), 4);
+}
+
+TEST(LinkCutTreeTests, TEST_MATCHES_NAIVE_FOREST) {
+    const int numVertices = 40;
+    mt19937 random(7);
+    LinkCutTree forest;
+    vector<set<int>> adjacent(numVertices);
+    vector<int> values(numVertices);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        // Distinct values, so the heaviest vertex of a path is unique
+        values[vertex] = (vertex * 17) % numVertices;
+        ASSERT_EQ(forest.addVertex(values[vertex]), vertex);
+    }
+
+    for (int step = 0; step < 5000; step++) {
+        int first = random() % numVertices;
+        int second = random() % numVertices;
+        vector<int> path = findPath(adjacent, first, second);
+        ASSERT_EQ(forest.connected(first, second), !path.empty());
+        if (path.empty()) {
+            forest.link(first, second);
+            adjacent[first].insert(second);
+            adjacent[second].insert(first);
+            continue;
+        }
+        int heaviest = path[0];
+        for (int vertex : path) {
+            if (values[vertex] > values[heaviest]) {
+                heaviest = vertex;
+            }
+        }
+        ASSERT_EQ(forest.findHeaviest(first, second), heaviest);
+        if (path.size() > 1 && random() % 3 == 0) {
+            // Cut an edge of the path, from either of its ends
+            int edge = random() % (path.size() - 1);
+            forest.cut(path[edge + 1], path[edge]);
+            adjacent[path[edge]].erase(path[edge + 1]);
+            adjacent[path[edge + 1]].erase(path[edge]);
+        }
+    }
+}
+
+TEST(IncrementalMSTTests, TEST_REPLACES_HEAVIEST_EDGE) {
+    ActorGraph graph;
+    IncrementalMST forest;
+    vector<Edge*> newEdges;
+    // Older movies are heavier, so A - B - C is replaced by the newer A - C
+    graph.addCastRow("A", "One", "1990", &newEdges);
+    graph.addCastRow("B", "One", "1990", &newEdges);
+    graph.addCastRow("B", "Two", "2000", &newEdges);
+    graph.addCastRow("C", "Two", "2000", &newEdges);
+    for (Edge* edge : newEdges) {
+        forest.addEdge(edge);
+    }
+    ASSERT_EQ(forest.getNumEdges(), 2);
+    long before = forest.getWeight();
+
+    newEdges.clear();
+    graph.addCastRow("A", "Three", "2010", &newEdges);
+    graph.addCastRow("C", "Three", "2010", &newEdges);
+    ASSERT_FALSE(newEdges.empty());
+    bool changed = false;
+    for (Edge* edge : newEdges) {
+        changed = forest.addEdge(edge) || changed;
+    }
+    ASSERT_TRUE(changed);
+    ASSERT_EQ(forest.getNumEdges(), 2);
+    ASSERT_LT(forest.getWeight(), before);
+    for (Edge* edge : forest.getEdges()) {
+        ASSERT_NE(graph.getMovieById(edge->getMovieId()).year, 1990);
+    }
+
+    // A heavier edge closing a cycle is dropped
+    newEdges.clear();
+    graph.addCastRow("A", "Four", "1980", &newEdges);
+    graph.addCastRow("B", "Four", "1980", &newEdges);
+    long after = forest.getWeight();
+    for (Edge* edge : newEdges) {
+        ASSERT_FALSE(forest.addEdge(edge));
+    }
+    ASSERT_EQ(forest.getWeight(), after);
+    graph.clear();
+}
+
+TEST(IncrementalMSTTests, TEST_MATCHES_KRUSKAL) {
+    const int numActors = 30;
+    mt19937 random(11);
+    ActorGraph graph;
+    IncrementalMST forest;
+    vector<Edge*> allEdges;
+    for (int movie = 0; movie < 80; movie++) {
+        vector<Edge*> newEdges;
+        string title = "Movie " + to_string(movie);
+        string year = to_string(1950 + random() % 60);
+        int castSize = 2 + random() % 3;
+        for (int actor = 0; actor < castSize; actor++) {
+            graph.addCastRow("Actor " + to_string(random() % numActors), title,
+                             year, &newEdges);
+        }
+        for (Edge* edge : newEdges) {
+            forest.addEdge(edge);
+        }
+        allEdges.insert(allEdges.end(), newEdges.begin(), newEdges.end());
+
+        // Kruskal over every edge so far
+        vector<Edge*> sorted = allEdges;
+        sort(sorted.begin(), sorted.end(), [](Edge* lhs, Edge* rhs) {
+            return lhs->getWeight() < rhs->getWeight();
+        });
+        DisjointSet sets(graph.getNumActors());
+        long weight = 0;
+        int numEdges = 0;
+        for (Edge* edge : sorted) {
+            if (sets.unite(edge->getSource()->getId(),
+                           edge->getDest()->getId())) {
+                weight += edge->getWeight();
+                numEdges++;
+            }
+        }
+        ASSERT_EQ(forest.getWeight(), weight);
+        ASSERT_EQ(forest.getNumEdges(), numEdges);
+        ASSERT_EQ((int)forest.getEdges().size(), numEdges);
+    }
+    graph.clear();
+}
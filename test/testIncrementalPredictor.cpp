@@ -0,0 +1,80 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ActorGraph.hpp"
+#include "CastRows.hpp"
+#include "CollabMatrix.hpp"
+#include "IncrementalPredictor.hpp"
+#include "LinkPredictor.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST(CollabMatrixTests, TEST_ADD_ENTRIES_MERGES_AND_GROWS) {
+    ActorGraph graph;
+    addRows(graph, {{"A", "One", "2000"},
+                    {"B", "One", "2000"},
+                    {"C", "One", "2000"}});
+    CollabMatrix matrix(graph, MIN_YEAR, MAX_YEAR);
+    ASSERT_EQ(matrix.getRow(0), (vector<Entry>{{1, 1}, {2, 1}}));
+
+    // Out of order, with repeats of an existing and of a new entry, and
+    // rows 3 and 4 for new actors, 4 left empty
+    vector<RowEntry> additions = {{3, {0, 2}}, {0, {2, 1}}, {0, {3, 1}},
+                                  {0, {2, 1}}, {0, {3, 1}}, {2, {1, 5}}};
+    matrix.addEntries(5, additions);
+    ASSERT_EQ(matrix.getNumRows(), 5);
+    ASSERT_EQ(matrix.getRow(0), (vector<Entry>{{1, 1}, {2, 3}, {3, 2}}));
+    ASSERT_EQ(matrix.getRow(1), (vector<Entry>{{0, 1}, {2, 1}}));
+    ASSERT_EQ(matrix.getRow(2), (vector<Entry>{{0, 1}, {1, 6}}));
+    ASSERT_EQ(matrix.getRow(3), (vector<Entry>{{0, 2}}));
+    ASSERT_TRUE(matrix.getRow(4).empty());
+
+    // Growing without additions only adds empty rows
+    additions.clear();
+    matrix.addEntries(6, additions);
+    ASSERT_EQ(matrix.getNumRows(), 6);
+    ASSERT_TRUE(matrix.getRow(5).empty());
+    ASSERT_EQ(matrix.getRow(3), (vector<Entry>{{0, 2}}));
+    graph.clear();
+}
+
+TEST(IncrementalPredictorTests, TEST_UPDATE_MATCHES_RECOMPUTE) {
+    ActorGraph graph;
+    addRows(graph, BASE_ROWS);
+    IncrementalPredictor incremental(graph, MIN_YEAR, MAX_YEAR, TOP_RANK, 2);
+
+    // F and G meet for the first time, with the new actor H
+    vector<Edge*> newEdges;
+    addRows(graph,
+            {{"F", "Six", "2005"}, {"G", "Six", "2005"}, {"H", "Six", "2005"}},
+            &newEdges);
+    ASSERT_EQ(newEdges.size(), 3u);
+    // F, G and H, and their collaborators B, E and C
+    ASSERT_EQ(incremental.addEdges(newEdges, 2), 6);
+
+    IncrementalPredictor recomputed(graph, MIN_YEAR, MAX_YEAR, TOP_RANK, 1);
+    for (int actor = 0; actor < graph.getNumActors(); actor++) {
+        ASSERT_EQ(incremental.getCollabs(actor),
+                  recomputed.getCollabs(actor));
+        ASSERT_EQ(incremental.getUncollabs(actor),
+                  recomputed.getUncollabs(actor));
+    }
+    graph.clear();
+}
+
+TEST(IncrementalPredictorTests, TEST_UPDATE_OUTSIDE_YEARS) {
+    ActorGraph graph;
+    addRows(graph, BASE_ROWS);
+    IncrementalPredictor incremental(graph, MIN_YEAR, 2004, TOP_RANK, 1);
+    vector<int> before = incremental.getUncollabs(0);
+
+    vector<Edge*> newEdges;
+    addRows(graph, {{"A", "Six", "2005"}, {"H", "Six", "2005"}}, &newEdges);
+    ASSERT_EQ(incremental.addEdges(newEdges, 1), 0);
+    ASSERT_EQ(incremental.getUncollabs(0), before);
+    // The new actor has an empty row and no predictions
+    ASSERT_TRUE(incremental.getCollabs(graph.getNumActors() - 1).empty());
+    graph.clear();
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "Intersect.hpp"
+
+using namespace std;
+using namespace testing;
+
+typedef int (*Kernel)(const int*, int, const int*, int, int*);
+
+/**
+ * Checks that every kernel finds the same shared ids as intersectMerge, with
+ * the same positions in the first array, with the arrays in both orders
+ * Params:
+ * - first: a strictly increasing array
+ * - second: another strictly increasing array
+ * Returns: void
+ */
+static void expectKernelsAgree(const vector<int>& first,
+                               const vector<int>& second) {
+    vector<Kernel> kernels = {intersectGallop, intersectSSE, intersect};
+    if (hasAVX2()) {
+        kernels.push_back(intersectAVX2);
+    }
+    for (int swapped = 0; swapped < 2; swapped++) {
+        const vector<int>& lhs = swapped ? second : first;
+        const vector<int>& rhs = swapped ? first : second;
+        int shorter = (int)min(lhs.size(), rhs.size());
+        vector<int> expected(shorter + 1);
+        int numShared = intersectMerge(lhs.data(), (int)lhs.size(), rhs.data(),
+                                       (int)rhs.size(), expected.data());
+        expected.resize(numShared);
+        for (int position : expected) {
+            ASSERT_EQ(set<int>(rhs.begin(), rhs.end()).count(lhs[position]),
+                      1u);
+        }
+        for (Kernel kernel : kernels) {
+            vector<int> matches(shorter + 1);
+            ASSERT_EQ(kernel(lhs.data(), (int)lhs.size(), rhs.data(),
+                             (int)rhs.size(), matches.data()),
+                      numShared);
+            matches.resize(numShared);
+            ASSERT_EQ(matches, expected);
+            ASSERT_EQ(kernel(lhs.data(), (int)lhs.size(), rhs.data(),
+                             (int)rhs.size(), nullptr),
+                      numShared);
+        }
+    }
+}
+
+/**
+ * Draws a strictly increasing array of ids below a bound
+ * Params:
+ * - random: the random number generator
+ * - length: the number of ids, at most bound
+ * - bound: the bound on the ids
+ * Returns: the sorted ids
+ */
+static vector<int> randomIds(mt19937& random, int length, int bound) {
+    set<int> ids;
+    while ((int)ids.size() < length) {
+        ids.insert(random() % bound);
+    }
+    return vector<int>(ids.begin(), ids.end());
+}
+
+TEST(IntersectTests, TEST_EMPTY_ARRAYS) {
+    expectKernelsAgree({}, {});
+    expectKernelsAgree({}, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+TEST(IntersectTests, TEST_LENGTHS_OFF_BLOCKS) {
+    // Lengths around and between the SSE and AVX2 block sizes
+    for (int firstLength = 1; firstLength <= 19; firstLength++) {
+        for (int secondLength = 1; secondLength <= 19; secondLength++) {
+            vector<int> first;
+            vector<int> second;
+            for (int id = 0; id < firstLength; id++) {
+                first.push_back(id * 2);
+            }
+            for (int id = 0; id < secondLength; id++) {
+                second.push_back(id * 3);
+            }
+            expectKernelsAgree(first, second);
+        }
+    }
+}
+
+TEST(IntersectTests, TEST_EQUAL_ARRAYS) {
+    for (int length : {1, 3, 4, 7, 8, 13, 16, 33}) {
+        vector<int> ids;
+        for (int id = 0; id < length; id++) {
+            ids.push_back(id * 5 + 1);
+        }
+        expectKernelsAgree(ids, ids);
+    }
+}
+
+TEST(IntersectTests, TEST_DISJOINT_ARRAYS) {
+    vector<int> evens;
+    vector<int> odds;
+    for (int id = 0; id < 37; id++) {
+        evens.push_back(id * 2);
+        odds.push_back(id * 2 + 1);
+    }
+    expectKernelsAgree(evens, odds);
+    // Every id of one array below every id of the other
+    expectKernelsAgree({1, 2, 3, 4, 5}, {10, 11, 12, 13, 14, 15, 16, 17, 18});
+}
+
+TEST(IntersectTests, TEST_SKEWED_RATIOS) {
+    mt19937 random(3);
+    // Ratios below and above GALLOP_RATIO, so intersect picks both kernels
+    for (int shortLength : {1, 5, 9, 31}) {
+        for (int ratio : {1, 2, 15, 16, 17, 64, 300}) {
+            int longLength = shortLength * ratio;
+            int bound = longLength * 2 + 10;
+            expectKernelsAgree(randomIds(random, shortLength, bound),
+                               randomIds(random, longLength, bound));
+        }
+    }
+}
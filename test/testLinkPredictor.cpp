@@ -0,0 +1,323 @@
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ActorGraph.hpp"
+#include "CastRows.hpp"
+#include "CollabMatrix.hpp"
+#include "LinkPredictor.hpp"
+#include "MinHashIndex.hpp"
+#include "TopKSelector.hpp"
+
+using namespace std;
+using namespace testing;
+
+/**
+ * Scores a candidate under a model straight from the definition, reading the
+ * rows of both actors and of every collaborator they share
+ * Params:
+ * - matrix: the collaboration matrix
+ * - model: the number of the model
+ * - actor: the id of the actor being predicted
+ * - candidate: the id of the candidate
+ * Returns: the score
+ */
+static double scoreByDefinition(CollabMatrix& matrix, int model, int actor,
+                                int candidate) {
+    vector<int> movies(matrix.getNumRows(), 0);
+    for (const Entry& entry : matrix.getRow(candidate)) {
+        movies[entry.first] = entry.second;
+    }
+    double weighted = 0;
+    double common = 0;
+    double adamicAdar = 0;
+    double resource = 0;
+    for (const Entry& entry : matrix.getRow(actor)) {
+        if (movies[entry.first] == 0) {
+            continue;
+        }
+        int degree = matrix.getRowLength(entry.first);
+        weighted += (double)entry.second * movies[entry.first];
+        common += 1;
+        adamicAdar += degree > 1 ? 1 / log(degree) : 0;
+        resource += 1.0 / degree;
+    }
+    double degrees = matrix.getRowLength(actor);
+    double candidateDegrees = matrix.getRowLength(candidate);
+    switch (model) {
+        case COMMON_MODEL:
+            return common;
+        case JACCARD_MODEL:
+            return common / (degrees + candidateDegrees - common);
+        case ADAMIC_ADAR_MODEL:
+            return adamicAdar;
+        case RESOURCE_MODEL:
+            return resource;
+        case PREFERENTIAL_MODEL:
+            return degrees * candidateDegrees;
+        case KATZ_MODEL: {
+            double direct = 0;
+            for (const Entry& entry : matrix.getRow(actor)) {
+                if (entry.first == candidate) {
+                    direct = entry.second;
+                }
+            }
+            return KATZ_BETA * direct + KATZ_BETA * KATZ_BETA * weighted;
+        }
+        default:
+            return weighted;
+    }
+}
+
+/**
+ * Marks the candidates of an actor in both lists
+ * Params:
+ * - matrix: the collaboration matrix
+ * - actor: the id of the actor
+ * - isCollab: filled with whether each id collaborated with the actor
+ * - isNew: filled with whether each id is two steps away from the actor
+ *   without having collaborated
+ * Returns: void
+ */
+static void findCandidates(CollabMatrix& matrix, int actor,
+                           vector<bool>& isCollab, vector<bool>& isNew) {
+    isCollab.assign(matrix.getNumRows(), false);
+    isNew.assign(matrix.getNumRows(), false);
+    for (const Entry& entry : matrix.getRow(actor)) {
+        isCollab[entry.first] = true;
+    }
+    for (const Entry& entry : matrix.getRow(actor)) {
+        for (const Entry& costar : matrix.getRow(entry.first)) {
+            if (costar.first != actor && !isCollab[costar.first]) {
+                isNew[costar.first] = true;
+            }
+        }
+    }
+}
+
+TEST_F(SmallCastGraph, TEST_HASH_ENGINE_UNKNOWN_ACTOR) {
+    vector<int> nameRanks = graph.getNameRanks();
+    ASSERT_TRUE(predictCollaborate(graph, "Nobody", MIN_YEAR, MAX_YEAR,
+                                   nameRanks, TOP_RANK)
+                    .empty());
+    ASSERT_TRUE(
+        predictNew(graph, "Nobody", MIN_YEAR, MAX_YEAR, nameRanks, TOP_RANK)
+            .empty());
+}
+
+TEST_F(SmallCastGraph, TEST_HASH_ENGINE_MATCHES_FUSED) {
+    vector<int> nameRanks = graph.getNameRanks();
+    CollabMatrix matrix(graph, MIN_YEAR, MAX_YEAR);
+    LinkPredictor predictor(graph, matrix, nameRanks);
+    for (int actor = 0; actor < graph.getNumActors(); actor++) {
+        string name = graph.getActorById(actor)->getName();
+        vector<string> collabs;
+        vector<string> uncollabs;
+        predictor.predict(actor, collabs, uncollabs);
+        ASSERT_EQ(predictCollaborate(graph, name, MIN_YEAR, MAX_YEAR,
+                                     nameRanks, TOP_RANK),
+                  collabs);
+        ASSERT_EQ(
+            predictNew(graph, name, MIN_YEAR, MAX_YEAR, nameRanks, TOP_RANK),
+            uncollabs);
+    }
+}
+
+TEST_F(SmallCastGraph, TEST_APPROXIMATE_MATCHES_EXACT_WHEN_SAMPLE_FITS) {
+    // Every neighborhood here is read within the sample budget
+    vector<int> nameRanks = graph.getNameRanks();
+    CollabMatrix matrix(graph, MIN_YEAR, MAX_YEAR);
+    MinHashIndex index(matrix, LSH_BANDS, LSH_ROWS, 1);
+    LinkPredictor exact(graph, matrix, nameRanks);
+    ApproximatePredictor approximate(graph, matrix, index, nameRanks);
+    for (int actor = 0; actor < graph.getNumActors(); actor++) {
+        vector<string> collabs;
+        vector<string> uncollabs;
+        vector<string> approximateCollabs;
+        vector<string> approximateUncollabs;
+        exact.predict(actor, collabs, uncollabs);
+        approximate.predict(actor, approximateCollabs, approximateUncollabs);
+        ASSERT_EQ(approximateCollabs, collabs);
+        ASSERT_EQ(approximateUncollabs, uncollabs);
+    }
+}
+
+TEST_F(SmallCastGraph, TEST_MODELS_MATCH_DEFINITIONS) {
+    vector<int> nameRanks = graph.getNameRanks();
+    CollabMatrix matrix(graph, MIN_YEAR, MAX_YEAR);
+    LinkPredictor predictor(graph, matrix, nameRanks);
+    vector<int> models;
+    for (int model = 0; model < NUM_MODELS; model++) {
+        models.push_back(model);
+    }
+    for (int actor = 0; actor < graph.getNumActors(); actor++) {
+        vector<vector<string>> collabs;
+        vector<vector<string>> uncollabs;
+        predictor.predict(actor, models, collabs, uncollabs);
+        ASSERT_EQ(collabs.size(), models.size());
+
+        vector<bool> isCollab;
+        vector<bool> isNew;
+        findCandidates(matrix, actor, isCollab, isNew);
+        for (int model : models) {
+            TopKSelector oldTop(nameRanks, TOP_RANK);
+            TopKSelector newTop(nameRanks, TOP_RANK);
+            for (int other = 0; other < graph.getNumActors(); other++) {
+                if (isCollab[other]) {
+                    oldTop.offer(
+                        scoreByDefinition(matrix, model, actor, other), other);
+                } else if (isNew[other]) {
+                    newTop.offer(
+                        scoreByDefinition(matrix, model, actor, other), other);
+                }
+            }
+            ASSERT_EQ(collabs[model], getNames(graph, oldTop.takeTop()))
+                << MODEL_NAMES[model];
+            ASSERT_EQ(uncollabs[model], getNames(graph, newTop.takeTop()))
+                << MODEL_NAMES[model];
+        }
+    }
+}
+
+TEST_F(SmallCastGraph, TEST_SCORE_PAIR_MATCHES_PREDICTOR) {
+    vector<int> nameRanks = graph.getNameRanks();
+    CollabMatrix matrix(graph, MIN_YEAR, MAX_YEAR);
+    LinkPredictor predictor(graph, matrix, nameRanks);
+    vector<int> matches;
+    vector<int> otherMatches;
+    vector<int> models;
+    for (int model = 0; model < NUM_MODELS; model++) {
+        models.push_back(model);
+    }
+    for (int actor = 0; actor < graph.getNumActors(); actor++) {
+        vector<vector<string>> collabs;
+        vector<vector<string>> uncollabs;
+        predictor.predict(actor, models, collabs, uncollabs);
+        vector<bool> isCollab;
+        vector<bool> isNew;
+        findCandidates(matrix, actor, isCollab, isNew);
+        for (int model : models) {
+            // Ranking the candidates by their pair scores gives the lists
+            TopKSelector oldTop(nameRanks, TOP_RANK);
+            TopKSelector newTop(nameRanks, TOP_RANK);
+            for (int other = 0; other < graph.getNumActors(); other++) {
+                if (other == actor) {
+                    continue;
+                }
+                double score = scorePair(matrix, model, actor, other, matches,
+                                         otherMatches);
+                ASSERT_DOUBLE_EQ(score,
+                                 scoreByDefinition(matrix, model, actor, other))
+                    << MODEL_NAMES[model];
+                if (isCollab[other]) {
+                    oldTop.offer(score, other);
+                } else if (isNew[other]) {
+                    newTop.offer(score, other);
+                }
+            }
+            ASSERT_EQ(collabs[model], getNames(graph, oldTop.takeTop()))
+                << MODEL_NAMES[model];
+            ASSERT_EQ(uncollabs[model], getNames(graph, newTop.takeTop()))
+                << MODEL_NAMES[model];
+        }
+    }
+}
+
+/**
+ * Predicts the actors two steps away from X in a graph where X reaches P
+ * through S, two costars, R1 and R2 through M, three costars, and Q1 to Q8
+ * through the hub H, nine costars. H is added first, so it has the lowest id.
+ * Params:
+ * - limits: bounds on the work of the prediction
+ * - work: set to the matrix entries read
+ * - truncated: set to whether the prediction hit a limit
+ * Returns: the names of every actor predicted two steps away
+ */
+static set<string> predictThroughHub(WorkLimits limits, long& work,
+                                     bool& truncated) {
+    ActorGraph graph;
+    vector<vector<string>> rows = {{"H", "Crowd", "2005"}};
+    for (int costar = 1; costar <= 8; costar++) {
+        rows.push_back({"Q" + to_string(costar), "Crowd", "2005"});
+    }
+    vector<vector<string>> neighbors = {
+        {"X", "Big", "2004"},   {"H", "Big", "2004"},   {"X", "Small", "2000"},
+        {"S", "Small", "2000"}, {"S", "Pair", "2001"},  {"P", "Pair", "2001"},
+        {"X", "Mid", "2002"},   {"M", "Mid", "2002"},   {"M", "Trio", "2003"},
+        {"R1", "Trio", "2003"}, {"R2", "Trio", "2003"}};
+    rows.insert(rows.end(), neighbors.begin(), neighbors.end());
+    addRows(graph, rows);
+    CollabMatrix matrix(graph, MIN_YEAR, MAX_YEAR);
+    LinkPredictor predictor(graph, matrix, graph.getNameRanks(), 20, limits);
+    vector<string> collabs;
+    vector<string> uncollabs;
+    predictor.predict(graph.getActorNode("X")->getId(), collabs, uncollabs);
+    work = predictor.getLastWork();
+    truncated = predictor.wasTruncated();
+    graph.clear();
+    return set<string>(uncollabs.begin(), uncollabs.end());
+}
+
+TEST(WorkLimitsTests, TEST_TRUNCATED_EXACTLY_WHEN_WORK_DROPPED) {
+    // X's row, then the rows of S, M and H
+    const long fullWork = 3 + 2 + 3 + 9;
+    long work;
+    bool truncated;
+    set<string> exact = predictThroughHub(WorkLimits(), work, truncated);
+    ASSERT_EQ(exact.size(), 11u);
+    ASSERT_EQ(work, fullWork);
+    ASSERT_FALSE(truncated);
+
+    // Limits that every collaborator fits drop nothing
+    WorkLimits limits;
+    limits.hubCap = 9;
+    limits.budget = fullWork;
+    ASSERT_EQ(predictThroughHub(limits, work, truncated), exact);
+    ASSERT_EQ(work, fullWork);
+    ASSERT_FALSE(truncated);
+
+    // A cap below H skips its costars, or reads a sample of them
+    limits = WorkLimits();
+    limits.hubCap = 8;
+    set<string> skipped = predictThroughHub(limits, work, truncated);
+    ASSERT_EQ(skipped, (set<string>{"P", "R1", "R2"}));
+    ASSERT_EQ(work, fullWork - 9);
+    ASSERT_TRUE(truncated);
+    limits.policy = CAP_SAMPLE;
+    predictThroughHub(limits, work, truncated);
+    ASSERT_EQ(work, fullWork - 1);
+    ASSERT_TRUE(truncated);
+}
+
+TEST(WorkLimitsTests, TEST_BUDGET_EXPANDS_FEWEST_COSTARS_FIRST) {
+    long work;
+    bool truncated;
+    WorkLimits limits;
+    // Room for S and M but not H, though H has the lowest id
+    limits.budget = 3 + 2 + 3;
+    ASSERT_EQ(predictThroughHub(limits, work, truncated),
+              (set<string>{"P", "R1", "R2"}));
+    ASSERT_EQ(work, limits.budget);
+    ASSERT_TRUE(truncated);
+
+    // Sampling spends what is left of the budget on H
+    limits.policy = CAP_SAMPLE;
+    limits.budget = 3 + 2 + 3 + 4;
+    set<string> sampled = predictThroughHub(limits, work, truncated);
+    ASSERT_EQ(work, limits.budget);
+    ASSERT_TRUE(truncated);
+    ASSERT_EQ(sampled.size(), 3u + 4u);
+    for (string name : {"P", "R1", "R2"}) {
+        ASSERT_EQ(sampled.count(name), 1u);
+    }
+
+    // Only S fits before M, so M's costars are dropped along with H's
+    limits.policy = CAP_SKIP;
+    limits.budget = 3 + 2 + 2;
+    ASSERT_EQ(predictThroughHub(limits, work, truncated),
+              (set<string>{"P"}));
+    ASSERT_EQ(work, 3 + 2);
+    ASSERT_TRUE(truncated);
+}
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ActorGraph.hpp"
+#include "Boruvka.hpp"
+#include "CastRows.hpp"
+#include "DisjointSet.hpp"
+#include "EdgeSort.hpp"
+#include "ExternalMST.hpp"
+#include "FilterKruskal.hpp"
+#include "Prim.hpp"
+
+using namespace std;
+using namespace testing;
+
+// File the generated graph is loaded through
+#define GRAPH_FILE "testMST.tsv"
+// Number of actors, split evenly between the groups movies draw casts from
+#define NUM_ACTORS 240
+#define NUM_GROUPS 4
+
+class TiedComponentGraph : public ::testing::Test {
+  protected:
+    ActorGraph graph;
+    vector<Edge*> edges;  // One edge per pair of costars, from the lower id
+
+  public:
+    TiedComponentGraph() {
+        // Casts never mix groups, so there are several components, and the
+        // years span a decade, so many edges share a weight
+        mt19937 random(5);
+        vector<vector<string>> rows;
+        vector<int> members(NUM_ACTORS / NUM_GROUPS);
+        for (int movie = 0; movie < 160; movie++) {
+            int group = movie % NUM_GROUPS;
+            int castSize = 2 + random() % 7;
+            string year = to_string(1990 + random() % 10);
+            for (int member = 0; member < (int)members.size(); member++) {
+                members[member] = group + NUM_GROUPS * member;
+            }
+            shuffle(members.begin(), members.end(), random);
+            for (int actor = 0; actor < castSize; actor++) {
+                rows.push_back({"Actor " + to_string(members[actor]),
+                                "Movie " + to_string(movie), year});
+            }
+        }
+        // An actor alone in a movie is a component of its own
+        rows.push_back({"Loner", "Solo", "1995"});
+        loadRows(graph, rows, GRAPH_FILE);
+
+        for (int id = 0; id < graph.getNumActors(); id++) {
+            for (Edge* edge : graph.getActorById(id)->getEdges()) {
+                if (id < edge->getDest()->getId()) {
+                    edges.push_back(edge);
+                }
+            }
+        }
+    }
+    ~TiedComponentGraph() { graph.clear(); }
+};
+
+/**
+ * Runs Kruskal's algorithm over edges already sorted by weight
+ * Params:
+ * - edges: the edges, from lightest to heaviest
+ * - numActors: the number of actors
+ * Returns: the edges of the minimum spanning forest
+ */
+static vector<Edge*> findKruskalForest(const vector<Edge*>& edges,
+                                       int numActors) {
+    DisjointSet sets(numActors);
+    vector<Edge*> forest;
+    for (Edge* edge : edges) {
+        if (sets.unite(edge->getSource()->getId(),
+                       edge->getDest()->getId())) {
+            forest.push_back(edge);
+        }
+    }
+    return forest;
+}
+
+/**
+ * Adds up the weights of a forest's edges
+ * Params:
+ * - forest: the edges
+ * Returns: the total weight
+ */
+static long totalWeight(const vector<Edge*>& forest) {
+    long weight = 0;
+    for (Edge* edge : forest) {
+        weight += edge->getWeight();
+    }
+    return weight;
+}
+
+TEST_F(TiedComponentGraph, TEST_ENGINES_AGREE) {
+    ASSERT_GT(graph.getNumComponents(), NUM_GROUPS);
+    vector<Edge*> sorted = edges;
+    sort(sorted.begin(), sorted.end(), [](Edge* lhs, Edge* rhs) {
+        return lhs->getWeight() < rhs->getWeight();
+    });
+    vector<Edge*> expected = findKruskalForest(sorted, graph.getNumActors());
+    long weight = totalWeight(expected);
+    int numEdges = graph.getNumActors() - graph.getNumComponents();
+    ASSERT_EQ((int)expected.size(), numEdges);
+
+    for (int numThreads : {1, 4}) {
+        vector<Edge*> copy = edges;
+        vector<Edge*> boruvka =
+            findBoruvkaForest(copy, graph.getNumActors(), numThreads);
+        ASSERT_EQ(totalWeight(boruvka), weight);
+        ASSERT_EQ((int)boruvka.size(), numEdges);
+
+        copy = edges;
+        sortEdgesByWeight(copy, numThreads);
+        ASSERT_TRUE(is_sorted(copy.begin(), copy.end(),
+                              [](Edge* lhs, Edge* rhs) {
+                                  return lhs->getWeight() < rhs->getWeight();
+                              }));
+        vector<Edge*> radix = findKruskalForest(copy, graph.getNumActors());
+        ASSERT_EQ(totalWeight(radix), weight);
+        ASSERT_EQ((int)radix.size(), numEdges);
+    }
+
+    vector<Edge*> copy = edges;
+    vector<Edge*> filter = findFilterKruskalForest(copy, graph.getNumActors());
+    ASSERT_EQ(totalWeight(filter), weight);
+    ASSERT_EQ((int)filter.size(), numEdges);
+
+    vector<Edge*> prim = findPrimForest(graph, nullptr);
+    ASSERT_EQ(totalWeight(prim), weight);
+    ASSERT_EQ((int)prim.size(), numEdges);
+}
+
+TEST_F(TiedComponentGraph, TEST_EXTERNAL_MERGES_RUNS) {
+    vector<Edge*> sorted = edges;
+    sort(sorted.begin(), sorted.end(), [](Edge* lhs, Edge* rhs) {
+        return lhs->getWeight() < rhs->getWeight();
+    });
+    long weight = totalWeight(findKruskalForest(sorted, graph.getNumActors()));
+
+    // A budget of one block per run, so the records are split into several
+    long external = 0;
+    int numEdges = 0;
+    int numRuns = 0;
+    size_t workBytes = 0;
+    bool found = true;
+    ASSERT_TRUE(findExternalForest(
+        graph, -1, MIN_READ_RECORDS * sizeof(EdgeRecord),
+        [&](const EdgeRecord& record) {
+            found = found && findRecordEdge(graph, record) != nullptr;
+            external += record.weight;
+            numEdges++;
+        },
+        &workBytes, &numRuns));
+    ASSERT_GT(numRuns, 2);
+    // Merging the runs in passes holds no more than the three blocks a merge
+    // needs, beside the union-find
+    ASSERT_LE(workBytes, 3 * MIN_READ_RECORDS * sizeof(EdgeRecord) +
+                             graph.getNumActors() * 2 * sizeof(int));
+    ASSERT_TRUE(found);
+    ASSERT_EQ(external, weight);
+    ASSERT_EQ(numEdges, graph.getNumActors() - graph.getNumComponents());
+
+    // Each component alone adds up to the whole forest
+    long components = 0;
+    for (int component = 0; component < graph.getNumComponents();
+         component++) {
+        ASSERT_TRUE(findExternalForest(
+            graph, component, MIN_READ_RECORDS * sizeof(EdgeRecord),
+            [&](const EdgeRecord& record) { components += record.weight; }));
+    }
+    ASSERT_EQ(components, weight);
+}
@@ -0,0 +1,72 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "CastRows.hpp"
+#include "PathTreeCache.hpp"
+
+using namespace std;
+using namespace testing;
+
+TEST_F(SmallCastGraph, TEST_LRU_EVICTION) {
+    PathTreeCache cache(graph, 2, MIN_YEAR, MAX_YEAR);
+    int a = graph.getActorNode("A")->getId();
+    int b = graph.getActorNode("B")->getId();
+    int c = graph.getActorNode("C")->getId();
+    int e = graph.getActorNode("E")->getId();
+    int f = graph.getActorNode("F")->getId();
+    int g = graph.getActorNode("G")->getId();
+    vector<Edge*> path;
+    bool reversed;
+
+    // Nothing is cached, so only a query allowed to build is answered
+    ASSERT_FALSE(cache.findPath(a, g, false, false, path, reversed));
+    ASSERT_TRUE(cache.findPath(a, g, false, true, path, reversed));
+    ASSERT_TRUE(cache.findPath(b, g, false, true, path, reversed));
+    ASSERT_EQ(cache.getMisses(), 2);
+
+    // Using A's tree makes B's the least recently used
+    ASSERT_TRUE(cache.findPath(a, e, false, false, path, reversed));
+    ASSERT_TRUE(cache.findPath(c, f, false, true, path, reversed));
+    ASSERT_EQ(cache.getMisses(), 3);
+    ASSERT_FALSE(cache.findPath(b, e, false, false, path, reversed));
+    ASSERT_TRUE(cache.findPath(a, e, false, false, path, reversed));
+    ASSERT_TRUE(cache.findPath(c, e, false, false, path, reversed));
+    ASSERT_EQ(cache.getHits(), 3);
+
+    // Weighted trees are cached apart from unweighted ones
+    ASSERT_FALSE(cache.findPath(a, e, true, false, path, reversed));
+    ASSERT_DOUBLE_EQ(cache.getHitRate(), 0.5);
+}
+
+TEST_F(SmallCastGraph, TEST_REVERSED_LOOKUP) {
+    PathTreeCache cache(graph, 2, MIN_YEAR, MAX_YEAR);
+    Node* a = graph.getActorNode("A");
+    Node* g = graph.getActorNode("G");
+    vector<Edge*> path;
+    bool reversed;
+
+    ASSERT_TRUE(cache.findPath(a->getId(), g->getId(), false, true, path,
+                               reversed));
+    ASSERT_FALSE(reversed);
+    ASSERT_EQ(path.size(), 2u);
+    ASSERT_EQ(path.front()->getSource(), a);
+    ASSERT_EQ(path.back()->getDest(), g);
+    vector<Edge*> forward = path;
+
+    // G's path is read off A's tree, from G's side back to A
+    ASSERT_TRUE(cache.findPath(g->getId(), a->getId(), false, false, path,
+                               reversed));
+    ASSERT_TRUE(reversed);
+    ASSERT_EQ(cache.getHits(), 1);
+    ASSERT_EQ(path.size(), forward.size());
+    ASSERT_EQ(path.front()->getDest(), g);
+    ASSERT_EQ(path.back()->getSource(), a);
+    for (int edge = 0; edge < (int)path.size(); edge++) {
+        ASSERT_EQ(path[edge], forward[forward.size() - 1 - edge]);
+    }
+
+    // A query from an actor to itself is an empty path
+    ASSERT_TRUE(cache.findPath(a->getId(), a->getId(), false, false, path,
+                               reversed));
+    ASSERT_TRUE(path.empty());
+}
@@ -0,0 +1,93 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ActorGraph.hpp"
+#include "CastRows.hpp"
+#include "ExclusionMask.hpp"
+#include "TemporalPaths.hpp"
+
+using namespace std;
+using namespace testing;
+
+#define GRAPH_FILE "testTemporalPaths.tsv"
+
+/**
+ * Finds the time-respecting path between two actors over every year
+ * Params:
+ * - graph: the graph of all actors
+ * - start: the name of the actor the path starts from
+ * - end: the name of the actor the path ends at
+ * - mask: the actors and movies the path must avoid, or nullptr
+ * Returns: the edges of the path, empty if there is none
+ */
+static vector<Edge*> findPath(ActorGraph& graph, string start, string end,
+                              ExclusionMask* mask = nullptr) {
+    vector<int> arrival(graph.getNumActors(), UNREACHED);
+    vector<Edge*> prev(graph.getNumActors(), nullptr);
+    vector<string> targets = {end};
+    vector<vector<Edge*>> paths = findTemporalPaths(
+        graph, start, targets, MIN_YEAR, MAX_YEAR, arrival, prev, mask);
+    // The scratch space is left as it was given
+    for (int year : arrival) {
+        EXPECT_EQ(year, UNREACHED);
+    }
+    return paths[0];
+}
+
+TEST(TemporalPathTests, TEST_BACK_IN_TIME_REJECTED) {
+    ActorGraph graph;
+    ASSERT_TRUE(loadRows(graph,
+                         {{"A", "Late", "2005"},
+                          {"B", "Late", "2005"},
+                          {"B", "Early", "2000"},
+                          {"C", "Early", "2000"}},
+                         GRAPH_FILE));
+    // A meets B only after B's movie with C
+    ASSERT_TRUE(findPath(graph, "A", "C").empty());
+
+    vector<Edge*> path = findPath(graph, "C", "A");
+    ASSERT_EQ(path.size(), 2u);
+    ASSERT_EQ(path[0]->getYear(), 2000);
+    ASSERT_EQ(path[1]->getYear(), 2005);
+    graph.clear();
+}
+
+TEST(TemporalPathTests, TEST_SAME_YEAR_HOPS_ALLOWED) {
+    ActorGraph graph;
+    ASSERT_TRUE(loadRows(graph,
+                         {{"A", "One", "2000"},
+                          {"B", "One", "2000"},
+                          {"B", "Two", "2000"},
+                          {"C", "Two", "2000"}},
+                         GRAPH_FILE));
+    vector<Edge*> path = findPath(graph, "A", "C");
+    ASSERT_EQ(path.size(), 2u);
+    ASSERT_EQ(path[0]->getDest(), graph.getActorNode("B"));
+    ASSERT_EQ(path[1]->getDest(), graph.getActorNode("C"));
+    graph.clear();
+}
+
+TEST(TemporalPathTests, TEST_EARLIEST_ARRIVAL_WINS) {
+    ActorGraph graph;
+    ASSERT_TRUE(loadRows(graph,
+                         {{"A", "Direct", "2010"},
+                          {"D", "Direct", "2010"},
+                          {"A", "First", "2001"},
+                          {"B", "First", "2001"},
+                          {"B", "Second", "2003"},
+                          {"D", "Second", "2003"}},
+                         GRAPH_FILE));
+    // Two hops reach D in 2003, before the direct movie of 2010
+    vector<Edge*> path = findPath(graph, "A", "D");
+    ASSERT_EQ(path.size(), 2u);
+    ASSERT_EQ(path[1]->getYear(), 2003);
+
+    // Without B only the direct movie is left
+    ExclusionMask mask(graph.getNumActors(), graph.getNumMovies());
+    mask.excludeActor(graph.getActorNode("B")->getId());
+    path = findPath(graph, "A", "D", &mask);
+    ASSERT_EQ(path.size(), 1u);
+    ASSERT_EQ(path[0]->getYear(), 2010);
+    graph.clear();
+}
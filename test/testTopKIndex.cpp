@@ -0,0 +1,49 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "ActorGraph.hpp"
+#include "CastRows.hpp"
+#include "CollabMatrix.hpp"
+#include "TopKIndex.hpp"
+
+using namespace std;
+using namespace testing;
+
+#define INDEX_NAME "testTopKIndex.idx"
+#define K 4
+
+TEST(TopKIndexTests, TEST_FINGERPRINT_REJECTS_CHANGED_GRAPH) {
+    vector<vector<string>> rows = {
+        {"A", "One", "2000"}, {"B", "One", "2000"}, {"C", "Two", "2001"},
+        {"D", "Two", "2001"}, {"A", "Two", "2001"}, {"B", "Three", "2002"},
+        {"D", "Three", "2002"}};
+    ActorGraph graph;
+    addRows(graph, rows);
+    CollabMatrix matrix(graph, MIN_YEAR, MAX_YEAR);
+    vector<int32_t> slots(graph.getNumActors() * 2 * K, MISSING_SLOT);
+    ASSERT_GT(TopKIndex::write(
+                  INDEX_NAME,
+                  TopKIndex::makeHeader(graph, matrix, K, MIN_YEAR, MAX_YEAR),
+                  slots),
+              0u);
+
+    TopKIndex index;
+    ASSERT_TRUE(index.open(INDEX_NAME));
+    ASSERT_TRUE(index.matches(graph, matrix, K, MIN_YEAR, MAX_YEAR));
+    ASSERT_FALSE(index.matches(graph, matrix, K - 1, MIN_YEAR, MAX_YEAR));
+
+    // Same actors and movies, but A and C trade their rows of Two
+    swap(rows[2][0], rows[4][0]);
+    ActorGraph changed;
+    addRows(changed, rows);
+    CollabMatrix changedMatrix(changed, MIN_YEAR, MAX_YEAR);
+    ASSERT_EQ(changed.getNumActors(), graph.getNumActors());
+    ASSERT_EQ(changed.getNumMovies(), graph.getNumMovies());
+    ASSERT_FALSE(index.matches(changed, changedMatrix, K, MIN_YEAR, MAX_YEAR));
+
+    graph.clear();
+    changed.clear();
+    remove(INDEX_NAME);
+}